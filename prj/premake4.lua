@@ -7,6 +7,15 @@ example: http://opende.svn.sourceforge.net/viewvc/opende/trunk/build/premake4.lu
 http://bitbucket.org/anders/lightweight/src/tip/premake4.lua
 
 ]]
+newoption {
+	trigger = "profile",
+	description = "Enable XMLObject load/save profiling counters"
+}
+newoption {
+	trigger = "alloc-count",
+	description = "Count allocations per library entry point"
+}
+
 solution "tinyobject"
 	configurations { "Debug", "Release" }
 	objdir "obj"
@@ -17,10 +26,18 @@ project "tinyobject"
 	language "C++"
 	targetdir "../src/tinyobject"
 	files { "../src/tinyobject/**.h", "../src/tinyobject/**.cpp" }
+	buildoptions { "-std=c++17" }
+
+	if _OPTIONS["profile"] then
+		defines { "TINYOBJECT_PROFILE" }
+	end
+	if _OPTIONS["alloc-count"] then
+		defines { "TINYOBJECT_ALLOC_COUNT" }
+	end
 
 	configuration "linux"
-		buildoptions { "`pkg-config --cflags tinyxml2`" }
-		linkoptions { "`pkg-config --libs tinyxml2`" }
+		buildoptions { "`pkg-config --cflags tinyxml2`", "-pthread" }
+		linkoptions { "`pkg-config --libs tinyxml2`", "-pthread" }
 
 	configuration "macosx"
 		-- Homebrew & MacPorts
@@ -45,10 +62,57 @@ project "totest"
 
 	includedirs { "../src" }
 	links { "tinyobject" }
+	buildoptions { "-std=c++17" }
+
+	configuration "linux"
+		buildoptions { "`pkg-config --cflags tinyxml2`", "-pthread" }
+		linkoptions { "`pkg-config --libs tinyxml2`", "-pthread" }
+
+	configuration "macosx"
+		-- Homebrew & MacPorts
+		includedirs { "/usr/local/include", "/opt/local/include"}
+		libdirs { "/usr/local/lib", "/opt/local/lib" }
+		buildoptions { "-fvisibility=default" }
+		links { "tinyxml2" }
+
+	configuration "Debug"
+		defines { "DEBUG" }
+		flags { "Symbols" }
+
+	configuration "Release"
+		defines { "NDEBUG" }
+		flags { "Optimize" }
+
+-- test document generator
+project "togen"
+	kind "ConsoleApp"
+	language "C++"
+	targetdir "../src/togen"
+	files { "../src/togen/**.h", "../src/togen/**.cpp" }
+	buildoptions { "-std=c++17" }
+
+	configuration "Debug"
+		defines { "DEBUG" }
+		flags { "Symbols" }
+
+	configuration "Release"
+		defines { "NDEBUG" }
+		flags { "Optimize" }
+
+-- benchmark executable
+project "bench"
+	kind "ConsoleApp"
+	language "C++"
+	targetdir "../src/bench"
+	files { "../src/bench/**.h", "../src/bench/**.cpp" }
+
+	includedirs { "../src" }
+	links { "tinyobject" }
+	buildoptions { "-std=c++17" }
 
 	configuration "linux"
-		buildoptions { "`pkg-config --cflags tinyxml2`" }
-		linkoptions { "`pkg-config --libs tinyxml2`" }
+		buildoptions { "`pkg-config --cflags tinyxml2`", "-pthread" }
+		linkoptions { "`pkg-config --libs tinyxml2`", "-pthread" }
 
 	configuration "macosx"
 		-- Homebrew & MacPorts
@@ -64,4 +128,3 @@ project "totest"
 	configuration "Release"
 		defines { "NDEBUG" }
 		flags { "Optimize" }
-		
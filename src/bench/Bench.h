@@ -0,0 +1,118 @@
+/*==============================================================================
+
+	Bench.h
+	
+	bench: benchmarks for tinyobject
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+/// \class Bench
+/// \brief minimal microbenchmark harness
+///
+/// each case is run in batches which grow until a batch takes at least the
+/// minimum time, then timed over a number of samples, results are printed as
+/// one JSON object per line:
+///
+///     {"name":"...","iterations":N,"ns_per_op":X,"min_ns_per_op":Y}
+///
+class Bench {
+
+	public:
+
+		/// benchmark body, called once per iteration
+		typedef std::function<void()> Func;
+
+		/// minTime: minimum batch time in ms, samples: timed batches per case
+		Bench(double minTime=50, unsigned int samples=5) :
+			m_minTime(minTime), m_samples(samples) {}
+
+		/// only run cases whose name contains the filter, empty runs all
+		inline void setFilter(std::string filter) {m_filter = filter;}
+
+		/// run & report a case
+		void run(const std::string &name, Func func) {
+			if(!m_filter.empty() && name.find(m_filter) == std::string::npos) {
+				return;
+			}
+
+			// calibrate batch size
+			unsigned long batch = 1;
+			while(true) {
+				double ns = time(func, batch);
+				if(ns >= m_minTime * 1000000.0 || batch >= (1ul << 30)) {
+					break;
+				}
+				batch *= (ns < m_minTime * 100000.0 ? 10 : 2);
+			}
+
+			// sample
+			double total = 0, best = 0;
+			for(unsigned int i = 0; i < m_samples; ++i) {
+				double ns = time(func, batch) / batch;
+				total += ns;
+				if(i == 0 || ns < best) {
+					best = ns;
+				}
+			}
+			std::cout << "{\"name\":\"" << name << "\""
+			          << ",\"iterations\":" << batch * m_samples
+			          << ",\"ns_per_op\":" << total / m_samples
+			          << ",\"min_ns_per_op\":" << best
+			          << "}" << std::endl;
+		}
+
+		/// keep the compiler from optimizing away a result,
+		/// compilers without GNU inline asm store its address to a volatile sink
+		template<class T> static void keep(const T &value) {
+			#if defined(__GNUC__) || defined(__clang__)
+				asm volatile("" : : "g"(&value) : "memory");
+			#else
+				static const volatile void *volatile sink;
+				sink = &value;
+				#ifdef _MSC_VER
+					_ReadWriteBarrier();
+				#endif
+			#endif
+		}
+
+	private:
+
+		/// time a batch, returns ns
+		double time(Func &func, unsigned long batch) {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for(unsigned long i = 0; i < batch; ++i) {
+				func();
+			}
+			return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		double m_minTime; ///< minimum batch time in ms
+		unsigned int m_samples; ///< timed batches per case
+		std::string m_filter; ///< case name filter
+};
@@ -0,0 +1,460 @@
+/*==============================================================================
+
+	main.cpp
+	
+	bench: benchmarks for tinyobject
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#include <tinyobject/tinyobject.h>
+#include <stdlib.h>
+#include <memory_resource>
+#include <sstream>
+#include "Bench.h"
+
+using namespace std;
+using namespace tinyxml2;
+
+// usage: bench [filter] [min batch time ms]
+//
+// prints one JSON object per benchmark case, ie.
+//     ./bench getChild > results.jsonl
+
+// string helper
+template<class T> static string str(const T &value) {
+	ostringstream stream;
+	stream << value;
+	return stream.str();
+}
+
+// add a chain of depth elements "d0/d1/..." below root with count "item"
+// siblings at the end, returns the path to the last item
+static string buildChain(XMLDocument &doc, XMLElement *root, int depth, int count) {
+	string path;
+	XMLElement *e = root;
+	for(int i = 0; i < depth; ++i) {
+		string name = "d" + str(i);
+		XMLElement *child = doc.NewElement(name.c_str());
+		e->InsertEndChild(child);
+		e = child;
+		path += name + "/";
+	}
+	for(int i = 0; i < count; ++i) {
+		XMLElement *item = doc.NewElement("item");
+		item->SetText(i);
+		e->InsertEndChild(item);
+	}
+	return path + "item/" + str(count-1);
+}
+
+// object with n subscribed element values & one attribute
+class BenchObject : public XMLObject {
+
+	public:
+
+		BenchObject(string name, int n) : XMLObject(name), values(n, 0.0f) {
+			subscribeXMLAttribute("", "name", XML_TYPE_STRING, &label);
+			for(int i = 0; i < n; ++i) {
+				subscribeXMLElement("v" + str(i), XML_TYPE_FLOAT, &values[i]);
+			}
+		}
+
+		string label;
+		vector<float> values;
+};
+
+// object with m attached children, each with n subscriptions
+class BenchRoot : public BenchObject {
+
+	public:
+
+		BenchRoot(int n, int m) : BenchObject("root", n) {
+			for(int i = 0; i < m; ++i) {
+				children.push_back(new BenchObject("child", n));
+				addXMLObject(children.back());
+			}
+		}
+
+		~BenchRoot() {
+			for(unsigned int i = 0; i < children.size(); ++i) {
+				delete children[i];
+			}
+		}
+
+		vector<BenchObject*> children;
+};
+
+static void benchPath(Bench &bench) {
+	bench.run("parsePath/names", [] {
+		Bench::keep(XML::parsePath("foo/bar/baz"));
+	});
+	bench.run("parsePath/indices", [] {
+		Bench::keep(XML::parsePath("foo/1/bar/2/baz/3"));
+	});
+
+	// runtime path string vs path split at compile time
+	XMLDocument doc;
+	XMLElement *root = doc.NewElement("root");
+	doc.InsertEndChild(root);
+	XML::obtainChild(root, "foo/1/bar/2/baz/3");
+	bench.run("getChild/string", [&] {
+		Bench::keep(XML::getChild(root, "foo/1/bar/2/baz/3"));
+	});
+	bench.run("getChild/literal", [&] {
+		Bench::keep(XML::getChild(root, XML_PATH("foo/1/bar/2/baz/3")));
+	});
+}
+
+static void benchChildren(Bench &bench) {
+	const int depths[] = {1, 4, 16};
+	const int counts[] = {1, 16, 256};
+	for(int d = 0; d < 3; ++d) {
+		for(int c = 0; c < 3; ++c) {
+			XMLDocument doc;
+			XMLElement *root = doc.NewElement("root");
+			doc.InsertEndChild(root);
+			string path = buildChain(doc, root, depths[d], counts[c]);
+			string suffix = "/depth" + str(depths[d]) + "/siblings" + str(counts[c]);
+			bench.run("getChild" + suffix, [&] {
+				Bench::keep(XML::getChild(root, path));
+			});
+			bench.run("obtainChild" + suffix, [&] {
+				Bench::keep(XML::obtainChild(root, path));
+			});
+		}
+	}
+}
+
+static void benchText(Bench &bench) {
+	XMLDocument doc;
+	XMLElement *e = doc.NewElement("value");
+	doc.InsertEndChild(e);
+
+	XML::setTextBool(e, true);
+	bench.run("getTextBool", [&] {Bench::keep(XML::getTextBool(e));});
+	bench.run("setTextBool", [&] {XML::setTextBool(e, true);});
+
+	XML::setTextInt(e, -123456);
+	bench.run("getTextInt", [&] {Bench::keep(XML::getTextInt(e));});
+	bench.run("setTextInt", [&] {XML::setTextInt(e, -123456);});
+
+	XML::setTextUInt(e, 123456);
+	bench.run("getTextUInt", [&] {Bench::keep(XML::getTextUInt(e));});
+	bench.run("setTextUInt", [&] {XML::setTextUInt(e, 123456);});
+
+	XML::setTextFloat(e, 89.3939f);
+	bench.run("getTextFloat", [&] {Bench::keep(XML::getTextFloat(e));});
+	bench.run("setTextFloat", [&] {XML::setTextFloat(e, 89.3939f);});
+
+	XML::setTextDouble(e, -129.232);
+	bench.run("getTextDouble", [&] {Bench::keep(XML::getTextDouble(e));});
+	bench.run("setTextDouble", [&] {XML::setTextDouble(e, -129.232);});
+
+	// tinyxml2 sscanf/snprintf conversions for comparison
+	int i = 0;
+	unsigned int u = 0;
+	float f = 0;
+	double d = 0;
+	XML::setTextInt(e, -123456);
+	bench.run("tinyxml2/getTextInt", [&] {e->QueryIntText(&i); Bench::keep(i);});
+	bench.run("tinyxml2/setTextInt", [&] {e->SetText(-123456);});
+	XML::setTextUInt(e, 123456);
+	bench.run("tinyxml2/getTextUInt", [&] {e->QueryUnsignedText(&u); Bench::keep(u);});
+	bench.run("tinyxml2/setTextUInt", [&] {e->SetText(123456u);});
+	XML::setTextFloat(e, 89.3939f);
+	bench.run("tinyxml2/getTextFloat", [&] {e->QueryFloatText(&f); Bench::keep(f);});
+	bench.run("tinyxml2/setTextFloat", [&] {e->SetText(89.3939f);});
+	XML::setTextDouble(e, -129.232);
+	bench.run("tinyxml2/getTextDouble", [&] {e->QueryDoubleText(&d); Bench::keep(d);});
+	bench.run("tinyxml2/setTextDouble", [&] {e->SetText(-129.232);});
+
+	XML::setTextString(e, "hello world");
+	bench.run("getTextString", [&] {Bench::keep(XML::getTextString(e));});
+	bench.run("getTextView", [&] {Bench::keep(XML::getTextView(e));});
+	bench.run("setTextString", [&] {XML::setTextString(e, "hello world");});
+
+	// subscribed string loads, the long text does not fit the small string buffer
+	XML::setTextString(e, "a string which is too long for the small string buffer");
+	string str;
+	string_view view;
+	XMLStringArena arena;
+	bench.run("getText/string", [&] {XML::getText(e, XML_TYPE_STRING, &str); Bench::keep(str);});
+	bench.run("getText/string_view", [&] {XML::getText(e, XML_TYPE_STRING_VIEW, &view); Bench::keep(view);});
+	bench.run("getText/string_view+intern", [&] {
+		XML::getText(e, XML_TYPE_STRING_VIEW, &view);
+		Bench::keep(arena.intern(view));
+	});
+}
+
+static void benchArray(Bench &bench) {
+	XMLDocument doc;
+	XMLElement *e = doc.NewElement("array");
+	doc.InsertEndChild(e);
+
+	const int sizes[] = {16, 4096, 262144};
+	for(int n = 0; n < 3; ++n) {
+		vector<float> values(sizes[n]);
+		for(int i = 0; i < sizes[n]; ++i) {
+			values[i] = i * 0.731f - 1000.0f;
+		}
+		XML::setTextArray(e, values);
+		string suffix = "/values" + str(sizes[n]);
+		vector<float> loaded;
+		bench.run("getTextArray" + suffix, [&] {
+			XML::getTextArray(e, loaded);
+			Bench::keep(loaded);
+		});
+		bench.run("setTextArray" + suffix, [&] {XML::setTextArray(e, values);});
+
+		// string & istringstream parsing for comparison
+		bench.run("getTextString+istringstream" + suffix, [&] {
+			istringstream stream(XML::getTextString(e));
+			loaded.clear();
+			float value;
+			while(stream >> value) {
+				loaded.push_back(value);
+			}
+			Bench::keep(loaded);
+		});
+	}
+}
+
+static void benchColumns(Bench &bench) {
+	XMLDocument doc;
+	XMLElement *root = doc.NewElement("records");
+	doc.InsertEndChild(root);
+	const int records = 100000;
+	for(int i = 0; i < records; ++i) {
+		XMLElement *e = doc.NewElement("object");
+		XML::setAttrString(e, "name", "object" + str(i));
+		XML::setAttrInt(e, "id", i);
+		XML::setAttrDouble(e, "x", i * 0.5);
+		XML::setTextFloat(XML::obtainChild(e, "bar"), i * 0.25f);
+		root->InsertEndChild(e);
+	}
+
+	vector<XMLColumn> columns;
+	columns.push_back(XMLColumn("", "name", XML_TYPE_STRING));
+	columns.push_back(XMLColumn("", "id", XML_TYPE_INT));
+	columns.push_back(XMLColumn("", "x", XML_TYPE_DOUBLE, true));
+	columns.push_back(XMLColumn("bar", "", XML_TYPE_FLOAT));
+	bench.run("getColumns/records" + str(records), [&] {
+		Bench::keep(XML::getColumns(root, "object", columns));
+	});
+
+	// per record getAttr*/getText* calls for comparison
+	vector<string> names;
+	vector<int> ids;
+	vector<double> xs;
+	vector<float> bars;
+	bench.run("getAttr+getText/records" + str(records), [&] {
+		names.clear();
+		ids.clear();
+		xs.clear();
+		bars.clear();
+		XMLElement *e = root->FirstChildElement("object");
+		for(; e != NULL; e = e->NextSiblingElement("object")) {
+			names.push_back(XML::getAttrString(e, "name"));
+			ids.push_back(XML::getAttrInt(e, "id"));
+			xs.push_back(XML::getAttrDouble(e, "x"));
+			bars.push_back(XML::getTextFloat(XML::getChild(e, "bar")));
+		}
+		Bench::keep(names);
+	});
+}
+
+static void benchObject(Bench &bench) {
+	const int subscriptions[] = {1, 16, 128};
+	const int objects[] = {0, 16, 128};
+	for(int s = 0; s < 3; ++s) {
+		for(int o = 0; o < 3; ++o) {
+			int n = subscriptions[s], m = objects[o];
+			BenchRoot root(n, m);
+			root.initXML();
+			XMLElement *e = root.getXMLRootElement();
+			root.saveXML(e); // create all elements
+			string suffix = "/subscriptions" + str(n) + "/objects" + str(m);
+			bench.run("loadXML" + suffix, [&] {root.loadXML(e);});
+			bench.run("saveXML" + suffix, [&] {root.saveXML(e);});
+			char buffer[8192];
+			std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+			bench.run("loadXML/monotonic" + suffix, [&] {
+				XMLMemoryScope scope(&arena);
+				root.loadXML(e);
+				arena.release();
+			});
+			root.setXMLPlanEnabled(true);
+			bench.run("loadXML/plan" + suffix, [&] {root.loadXML(e);});
+			bench.run("saveXML/plan" + suffix, [&] {root.saveXML(e);});
+		}
+	}
+}
+
+static void benchValueCache(Bench &bench) {
+	BenchObject object("root", 16);
+	object.initXML();
+	XMLElement *e = object.getXMLRootElement();
+	object.saveXML(e); // create all elements
+	bench.run("getXMLTextFloat", [&] {Bench::keep(object.getXMLTextFloat("v15"));});
+	bench.run("getXMLAttrString", [&] {Bench::keep(object.getXMLAttrString("", "name"));});
+	object.setXMLValueCacheEnabled(true);
+	bench.run("getXMLTextFloat/cached", [&] {Bench::keep(object.getXMLTextFloat("v15"));});
+	bench.run("getXMLAttrString/cached", [&] {Bench::keep(object.getXMLAttrString("", "name"));});
+}
+
+// object with n subscribed int attributes on its own element
+class BenchAttrObject : public XMLObject {
+
+	public:
+
+		BenchAttrObject(int n) : XMLObject("attrs"), values(n, 0) {
+			for(int i = 0; i < n; ++i) {
+				subscribeXMLAttribute("", "a" + str(i), XML_TYPE_INT, &values[i]);
+			}
+		}
+
+		vector<int> values;
+};
+
+static void benchAttributes(Bench &bench) {
+	const int attributes[] = {4, 32, 128};
+	for(int a = 0; a < 3; ++a) {
+		int n = attributes[a];
+		BenchAttrObject object(n);
+		object.initXML();
+		XMLElement *e = object.getXMLRootElement();
+		for(int i = n-1; i >= 0; --i) { // reverse of the subscription order
+			e->SetAttribute(("a" + str(i)).c_str(), i);
+		}
+		string suffix = "/attributes" + str(n);
+
+		// one lookup per attribute vs a single walk
+		vector<string> names(n);
+		vector<XMLAttr> attrs;
+		for(int i = 0; i < n; ++i) {
+			names[i] = "a" + str(i);
+			attrs.push_back(XMLAttr(names[i], XML_TYPE_INT, &object.values[i]));
+		}
+		bench.run("getAttr" + suffix, [&] {
+			for(int i = 0; i < n; ++i) {
+				XML::getAttr(e, attrs[i].name, attrs[i].type, attrs[i].var);
+			}
+		});
+		bench.run("getAttrs" + suffix, [&] {Bench::keep(XML::getAttrs(e, attrs));});
+		bench.run("loadXML" + suffix, [&] {object.loadXML(e);});
+	}
+}
+
+// child object created by a factory, registered for several element names
+class BenchShape : public XMLObject {
+
+	public:
+
+		BenchShape() : XMLObject("shape"), size(0) {
+			subscribeXMLAttribute("", "size", XML_TYPE_INT, &size);
+		}
+
+		int size;
+};
+
+// object with factory created children
+class BenchScene : public XMLObject {
+
+	public:
+
+		BenchScene(XMLObjectFactory *factory) : XMLObject("scene") {
+			subscribeXMLFactory("", factory, &children, true);
+		}
+
+		vector<XMLObject*> children; // owned by the factory
+};
+
+// reload alternating child sets, returns false if the factory created objects
+// once both sets were loaded
+static bool benchFactory(Bench &bench) {
+	const int children[] = {16, 128};
+	bool ret = true;
+	for(int c = 0; c < 2; ++c) {
+		int n = children[c];
+		XMLObjectFactory factory;
+		factory.addType<BenchShape>("a");
+		factory.addType<BenchShape>("b");
+		BenchScene scene(&factory);
+
+		// two child sets with different counts & element orders
+		XMLDocument docs[2];
+		XMLElement *scenes[2];
+		for(int d = 0; d < 2; ++d) {
+			scenes[d] = docs[d].NewElement("scene");
+			docs[d].InsertEndChild(scenes[d]);
+			int count = (d == 0 ? n : n - n/4);
+			for(int i = 0; i < count; ++i) {
+				XMLElement *e = docs[d].NewElement((i + d) % 3 == 0 ? "a" : "b");
+				e->SetAttribute("size", i);
+				scenes[d]->InsertEndChild(e);
+			}
+		}
+		scene.loadXML(scenes[0]);
+		scene.loadXML(scenes[1]);
+		unsigned int created = factory.getNumCreated();
+
+		string name = "loadXML/factory/children" + str(n);
+		int next = 0;
+		bench.run(name, [&] {
+			scene.loadXML(scenes[next]);
+			next = 1 - next;
+		});
+		if(factory.getNumCreated() != created) {
+			cerr << name << ": FAILED: created " << factory.getNumCreated() - created
+			     << " objects while reloading" << endl;
+			ret = false;
+		}
+	}
+	return ret;
+}
+
+static void benchFile(Bench &bench) {
+	const int objects[] = {16, 1024};
+	for(int o = 0; o < 2; ++o) {
+		BenchRoot root(16, objects[o]);
+		if(!root.saveXMLFile("bench.xml")) {
+			continue;
+		}
+		string suffix = "/objects" + str(objects[o]);
+		bench.run("loadXMLFile" + suffix, [&] {root.loadXMLFile("bench.xml");});
+		bench.run("saveXMLFile" + suffix, [&] {root.saveXMLFile("bench.xml");});
+		root.closeXMLFile();
+	}
+}
+
+int main(int argc, char *argv[]) {
+	Bench bench(argc > 2 ? atof(argv[2]) : 50);
+	if(argc > 1) {
+		bench.setFilter(argv[1]);
+	}
+	benchPath(bench);
+	benchChildren(bench);
+	benchText(bench);
+	benchArray(bench);
+	benchColumns(bench);
+	benchObject(bench);
+	benchValueCache(bench);
+	benchAttributes(bench);
+	bool ret = benchFactory(bench);
+	benchFile(bench);
+	return ret ? 0 : 1;
+}
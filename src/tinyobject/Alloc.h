@@ -0,0 +1,56 @@
+/*==============================================================================
+
+	Alloc.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+// internal allocation accounting hooks, only compiled in when
+// TINYOBJECT_ALLOC_COUNT is defined (configure --enable-alloc-count),
+// otherwise XML_ALLOC_SCOPE is empty
+
+#ifdef TINYOBJECT_ALLOC_COUNT
+
+#include "XMLAlloc.h"
+
+namespace tinyxml2 {
+
+/// marks the current thread as inside an entry point until destroyed
+class XMLAllocScope {
+
+	public:
+
+		XMLAllocScope(XMLAllocEntry entry);
+		~XMLAllocScope();
+
+	private:
+
+		uint32_t m_previous; ///< previous entry mask
+};
+
+} // namespace
+
+#define XML_ALLOC_SCOPE(entry) tinyxml2::XMLAllocScope _allocScope(entry)
+
+#else
+
+#define XML_ALLOC_SCOPE(entry)
+
+#endif
@@ -0,0 +1,236 @@
+/*==============================================================================
+
+	Convert.h
+
+	tinyobject: object-based xml classes for TinyXml-2
+
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include <charconv>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// floating point from_chars/to_chars need GCC 11, Visual Studio 2019 16.4 or
+// libc++ 20, configure checks for them, otherwise the library feature macro
+// is used & older standard libraries fall back to strtod/snprintf
+#if !defined(TINYOBJECT_FLOAT_CHARCONV) && defined(__cpp_lib_to_chars)
+	#define TINYOBJECT_FLOAT_CHARCONV
+#endif
+
+namespace tinyxml2 {
+
+/// internal number <-> text conversion using from_chars/to_chars,
+/// locale independent & floats are written as shortest round-trip text
+///
+/// reading accepts the same input as the sscanf-based tinyxml2 conversions:
+/// leading whitespace, an optional '+', a 0x prefix for integers & any
+/// trailing characters after the number
+struct XMLConvert {
+
+	/// max text size of a converted number, including the terminating '\0'
+	static const int TEXT_SIZE = 32;
+
+	/// convert the number at the beginning of [begin, end), returns a pointer
+	/// to the first character after the number or NULL if there is no number
+	template<class T> static const char* toNumber(const char *begin, const char *end, T &value) {
+		while(begin < end && isSpace(*begin)) {
+			++begin;
+		}
+		if(begin < end && *begin == '+' && (begin+1 == end || begin[1] != '-')) {
+			++begin;
+		}
+		std::from_chars_result result;
+		if constexpr(std::is_integral<T>::value) {
+			if(end-begin > 2 && begin[0] == '0' && (begin[1] == 'x' || begin[1] == 'X')) {
+				result = std::from_chars(begin+2, end, value, 16);
+			}
+			else {
+				result = std::from_chars(begin, end, value);
+			}
+		}
+		else {
+			result = fromChars(begin, end, value);
+		}
+		return result.ec == std::errc() ? result.ptr : NULL;
+	}
+
+	/// convert a number, returns true on success
+	template<class T> static bool toValue(const char *text, T &value) {
+		return toNumber(text, text+strlen(text), value) != NULL;
+	}
+
+	/// convert a bool, accepts numbers (non-zero is true) & "true"/"false"
+	/// as lowercase, capitalized or uppercase, returns true on success
+	static bool toValue(const char *text, bool &value) {
+		int i = 0;
+		if(toValue(text, i)) {
+			value = (i != 0);
+			return true;
+		}
+		if(!strcmp(text, "true") || !strcmp(text, "True") || !strcmp(text, "TRUE")) {
+			value = true;
+			return true;
+		}
+		if(!strcmp(text, "false") || !strcmp(text, "False") || !strcmp(text, "FALSE")) {
+			value = false;
+			return true;
+		}
+		return false;
+	}
+
+	/// write a number into a text buffer, returns the buffer
+	template<class T> static const char* toText(char (&buffer)[TEXT_SIZE], T value) {
+		*toChars(buffer, buffer+TEXT_SIZE-1, value).ptr = '\0';
+		return buffer;
+	}
+
+	/// convert numbers separated by any mix of whitespace & commas,
+	/// values is cleared & keeps its capacity, returns false if a value is
+	/// not a number
+	///
+	/// numbers are parsed in a single forward pass with no intermediate
+	/// copies, the separators between them are usually 1 or 2 characters so
+	/// from_chars is the limiting factor
+	template<class T> static bool toArray(const char *text, std::vector<T> &values) {
+		values.clear();
+		const char *p = text, *end = text + strlen(text);
+		while(true) {
+			while(p < end && isSeparator(*p)) {
+				++p;
+			}
+			if(p == end) {
+				return true;
+			}
+			T value;
+			const char *next = toNumber(p, end, value);
+			if(next == NULL || (next < end && !isSeparator(*next))) {
+				values.clear();
+				return false;
+			}
+			values.push_back(value);
+			p = next;
+		}
+	}
+
+	/// write numbers separated by spaces, text is replaced & keeps its capacity
+	template<class T> static void toArrayText(const std::vector<T> &values, std::string &text) {
+		text.resize(values.size() * TEXT_SIZE);
+		char *p = &text[0], *end = p + text.size();
+		for(size_t i = 0; i < values.size(); ++i) {
+			if(i > 0) {
+				*p++ = ' ';
+			}
+			p = toChars(p, end, values[i]).ptr;
+		}
+		text.resize(p - text.data());
+	}
+
+#ifdef TINYOBJECT_FLOAT_CHARCONV
+
+	/// floating point from_chars
+	template<class T> static std::from_chars_result fromChars(const char *begin, const char *end, T &value) {
+		return std::from_chars(begin, end, value);
+	}
+
+	/// to_chars, shortest round-trip text for floating point
+	template<class T> static std::to_chars_result toChars(char *begin, char *end, T value) {
+		return std::to_chars(begin, end, value);
+	}
+
+#else
+
+	/// floating point from_chars fallback using strtof/strtod,
+	/// numbers longer than 127 characters are cut off
+	template<class T> static std::from_chars_result fromChars(const char *begin, const char *end, T &value) {
+		char buffer[128];
+		size_t size = (end-begin < (long)sizeof(buffer) ? end-begin : sizeof(buffer)-1);
+		memcpy(buffer, begin, size);
+		buffer[size] = '\0';
+		char *next = NULL;
+		errno = 0;
+		if constexpr(std::is_same<T, float>::value) {
+			value = strtof(buffer, &next);
+		}
+		else {
+			value = strtod(buffer, &next);
+		}
+		std::from_chars_result result = {begin + (next - buffer), std::errc()};
+		if(next == buffer) {
+			result.ec = std::errc::invalid_argument;
+		}
+		else if(errno == ERANGE) {
+			result.ec = std::errc::result_out_of_range;
+		}
+		return result;
+	}
+
+	/// to_chars fallback, floating point values are written as the shortest
+	/// text which reads back as the same value, ie. 100 rather than 1e+02
+	template<class T> static std::to_chars_result toChars(char *begin, char *end, T value) {
+		if constexpr(std::is_integral<T>::value) {
+			return std::to_chars(begin, end, value);
+		}
+		else {
+			char buffer[TEXT_SIZE], shortest[TEXT_SIZE];
+			int size = 0, length = 0;
+			for(int precision = 1; precision <= std::numeric_limits<T>::max_digits10; ++precision) {
+				length = snprintf(buffer, sizeof(buffer), "%.*g", precision, (double)value);
+				T check;
+				if(fromChars(buffer, buffer+length, check).ec == std::errc() && check == value) {
+					if(size == 0 || length < size) {
+						memcpy(shortest, buffer, length);
+						size = length;
+					}
+					if(!memchr(buffer, 'e', length)) {
+						break; // more precision only adds digits
+					}
+				}
+			}
+			if(size == 0) { // nan
+				memcpy(shortest, buffer, length);
+				size = length;
+			}
+			if(size > end-begin) {
+				return {end, std::errc::value_too_large};
+			}
+			memcpy(begin, shortest, size);
+			return {begin + size, std::errc()};
+		}
+	}
+
+#endif
+
+	/// is c an array separator?
+	static inline bool isSeparator(char c) {
+		return c == ',' || isSpace(c);
+	}
+
+	/// is c whitespace? does not depend on the locale
+	static inline bool isSpace(char c) {
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+	}
+};
+
+} // namespace
@@ -22,59 +22,74 @@
 
 #include <iostream>
 #include <sstream>
+#include "LogSink.h"
+
+// compile time minimum severity, see LogSink::getSeverity(),
+// lines below are removed by the compiler: debug lines without DEBUG
+#ifndef LOG_MIN_SEVERITY
+	#ifdef DEBUG
+		#define LOG_MIN_SEVERITY 0
+	#else
+		#define LOG_MIN_SEVERITY 1
+	#endif
+#endif
+
+// only construct & format a line if the level is enabled,
+// the empty if branch keeps a following else bound correctly
+#define LOG_IF_ENABLED(level) \
+	if(!LogSink::isEnabled(level, LOG_MIN_SEVERITY)) {} else
+
+// rate limit per call site via a static LogLimit in a unique lambda,
+// the for loop runs at most once & carries the suppressed count
+#define LOG_LIMITED(level) \
+	LOG_IF_ENABLED(level) \
+	for(long _logSuppressed = []() -> LogLimit& {static LogLimit limit; return limit;}().check(); \
+	    _logSuppressed >= 0; _logSuppressed = -1) \
+		Log(level, _logSuppressed)
 
 // convenience defines
-#define LOG        Log(Log::LOG_LEVEL_NORMAL)
-#define LOG_DEBUG  Log(Log::LOG_LEVEL_DEBUG)
-#define LOG_WARN   Log(Log::LOG_LEVEL_WARN)
-#define LOG_ERROR  Log(Log::LOG_LEVEL_ERROR)
+#define LOG        LOG_IF_ENABLED(Log::LOG_LEVEL_NORMAL) Log(Log::LOG_LEVEL_NORMAL)
+#define LOG_DEBUG  LOG_IF_ENABLED(Log::LOG_LEVEL_DEBUG) Log(Log::LOG_LEVEL_DEBUG)
+#define LOG_WARN   LOG_IF_ENABLED(Log::LOG_LEVEL_WARN) Log(Log::LOG_LEVEL_WARN)
+#define LOG_ERROR  LOG_IF_ENABLED(Log::LOG_LEVEL_ERROR) Log(Log::LOG_LEVEL_ERROR)
+
+// rate limited defines for lines which may repeat in loops
+#define LOG_WARN_LIMITED   LOG_LIMITED(Log::LOG_LEVEL_WARN)
+#define LOG_ERROR_LIMITED  LOG_LIMITED(Log::LOG_LEVEL_ERROR)
 
 /// \class Log
 /// \brief a simple stream-based logger
 ///
+/// finished lines are passed to the current LogSink, see LogSink::setSink()
+///
 /// class idea from:
 /// http://www.gamedev.net/community/forums/topic.asp?topic_id=525405&whichpage=1&#3406418
 /// how to catch std::endl (which is actually a func pointer):
 /// http://yvan.seth.id.au/Entries/Technology/Code/std__endl.html
 ///
-class Log {
+class Log : public LogLevel {
 
 	public:
 
-		/// log level enum
-		enum Level {
-			LOG_LEVEL_NORMAL,
-			LOG_LEVEL_DEBUG,
-			LOG_LEVEL_WARN,
-			LOG_LEVEL_ERROR
-		};
-
 		/// select log level, default: normal
 		Log(Level level=LOG_LEVEL_NORMAL) : m_level(level) {}
 
-		/// does the actual printing on exit
+		/// select log level & report a number of suppressed similar lines
+		Log(Level level, long suppressed) : m_level(level) {
+			if(suppressed > 0) {
+				m_line << "(" << suppressed << " similar suppressed) ";
+			}
+		}
+
+		/// passes the line to the current sink on exit
 		~Log() {
-			switch(m_level) {
-
-				case LOG_LEVEL_NORMAL:
-					// must flush or we wont get any output until *after* the mainLoop
-					std::cout << m_line.str();
-					break;
-
-				case LOG_LEVEL_DEBUG:
-					#ifdef DEBUG
-					std::cout << "Debug: " << m_line.str();
-					#endif
-					break;
-
-				case LOG_LEVEL_WARN:
-					std::cerr << "Warn: " << m_line.str();
-					break;
-
-				case LOG_LEVEL_ERROR:
-					std::cerr << "Error: " << m_line.str();
-					break;
+			#ifndef DEBUG
+			if(m_level == LOG_LEVEL_DEBUG) {
+				return;
 			}
+			#endif
+			std::string line = m_line.str();
+			LogSink::print(m_level, line.c_str(), line.size());
 		}
 
 		/// catch << with a template class to read any type of data
@@ -0,0 +1,284 @@
+/*==============================================================================
+
+	LogSink.cpp
+
+	Copyright (C) 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#include "LogSink.h"
+
+#include <iostream>
+#include <string.h>
+#include <chrono>
+#include <mutex>
+#ifdef _WIN32
+	#include <io.h>
+	#define write_fd _write
+#else
+	#include <unistd.h>
+	#define write_fd ::write
+#endif
+
+// LOG SINK
+
+// current global sink, NULL for the default
+static std::atomic<LogSink*> s_sink(NULL);
+
+// lines being written to the global sink per parity & the parity for new
+// lines, a replaced sink is only let go once the lines which may still be
+// using it are written, see XMLPublished
+static std::atomic<unsigned int> s_writers[2];
+static std::atomic<unsigned int> s_epoch(0);
+static std::mutex s_replaceMutex;
+
+// wait for the lines which started before the sink was replaced
+static void waitForWriters() {
+	std::lock_guard<std::mutex> lock(s_replaceMutex);
+	for(int i = 0; i < 2; ++i) {
+		unsigned int parity = s_epoch.fetch_add(1) & 1;
+		while(s_writers[parity].load() != 0) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+// function static so it is usable during static initialization
+static LogSink& defaultSink() {
+	static LogStreamSink sink;
+	return sink;
+}
+
+void LogSink::setSink(LogSink *sink) {
+	s_sink.store(sink);
+	waitForWriters();
+}
+
+LogSink* LogSink::getSink() {
+	LogSink *sink = s_sink.load();
+	return (sink == NULL ? &defaultSink() : sink);
+}
+
+void LogSink::print(Level level, const char *line, size_t length) {
+	unsigned int parity = s_epoch.load() & 1;
+	s_writers[parity].fetch_add(1);
+	getSink()->write(level, line, length);
+	s_writers[parity].fetch_sub(1);
+}
+
+const char* LogSink::getPrefix(Level level) {
+	switch(level) {
+		case LOG_LEVEL_DEBUG:
+			return "Debug: ";
+		case LOG_LEVEL_WARN:
+			return "Warn: ";
+		case LOG_LEVEL_ERROR:
+			return "Error: ";
+		default: // LOG_LEVEL_NORMAL
+			return "";
+	}
+}
+
+// current runtime threshold
+static std::atomic<int> s_threshold(LogSink::LOG_LEVEL_DEBUG);
+
+void LogSink::setThreshold(Level level) {
+	s_threshold.store(level, std::memory_order_relaxed);
+}
+
+LogSink::Level LogSink::getThreshold() {
+	return (Level) s_threshold.load(std::memory_order_relaxed);
+}
+
+// LOG LIMIT
+
+// monotonic time in ms
+static long long millis() {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+LogLimit::LogLimit(unsigned int burst, unsigned int interval) :
+	m_burst(burst), m_interval(interval),
+	m_start(millis()), m_count(0), m_suppressed(0) {}
+
+long LogLimit::check() {
+	long long now = millis();
+	long long start = m_start.load(std::memory_order_relaxed);
+	if(now - start >= m_interval) {
+		// new interval, only one thread gets to reset the count
+		if(m_start.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+			m_count.store(0, std::memory_order_relaxed);
+		}
+	}
+	if(m_count.fetch_add(1, std::memory_order_relaxed) < m_burst) {
+		return m_suppressed.exchange(0, std::memory_order_relaxed);
+	}
+	m_suppressed.fetch_add(1, std::memory_order_relaxed);
+	return -1;
+}
+
+// LOG STREAM SINK
+
+void LogStreamSink::write(Level level, const char *line, size_t length) {
+	switch(level) {
+		case LOG_LEVEL_NORMAL:
+		case LOG_LEVEL_DEBUG:
+			std::cout << getPrefix(level);
+			std::cout.write(line, length);
+			break;
+		case LOG_LEVEL_WARN:
+		case LOG_LEVEL_ERROR:
+			std::cerr << getPrefix(level);
+			std::cerr.write(line, length);
+			break;
+	}
+}
+
+// LOG ASYNC SINK
+
+LogAsyncSink::LogAsyncSink(unsigned int capacity) : m_fd(-1) {
+	setup(capacity);
+}
+
+LogAsyncSink::LogAsyncSink(int fd, unsigned int capacity) : m_fd(fd) {
+	setup(capacity);
+}
+
+LogAsyncSink::LogAsyncSink(Callback callback, unsigned int capacity) :
+	m_fd(-1), m_callback(callback) {
+	setup(capacity);
+}
+
+LogAsyncSink::~LogAsyncSink() {
+	LogSink *self = this;
+	if(s_sink.compare_exchange_strong(self, NULL)) {
+		waitForWriters();
+	}
+	m_running.store(false);
+	if(m_thread.joinable()) {
+		m_thread.join();
+	}
+	delete [] m_slots;
+}
+
+// bounded MPMC queue after Dmitry Vyukov:
+// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+void LogAsyncSink::write(Level level, const char *line, size_t length) {
+	_Slot *slot;
+	size_t pos = m_head.load(std::memory_order_relaxed);
+	while(true) {
+		slot = &m_slots[pos & m_mask];
+		size_t seq = slot->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+		if(diff == 0) { // free slot, try to claim it
+			if(m_head.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+		else if(diff < 0) { // full
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else { // claimed by another writer, reload
+			pos = m_head.load(std::memory_order_relaxed);
+		}
+	}
+
+	// prefix + line, truncated to fit
+	const char *prefix = getPrefix(level);
+	size_t prefixLen = strlen(prefix);
+	if(prefixLen + length > LINE_SIZE) {
+		length = LINE_SIZE - prefixLen;
+	}
+	memcpy(slot->line, prefix, prefixLen);
+	memcpy(slot->line + prefixLen, line, length);
+	slot->length = prefixLen + length;
+	slot->level = level;
+	slot->sequence.store(pos+1, std::memory_order_release);
+}
+
+void LogAsyncSink::flush() {
+	size_t target = m_head.load();
+	while(m_written.load() < target && m_running.load()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+// PRIVATE
+
+void LogAsyncSink::setup(unsigned int capacity) {
+	size_t size = 2;
+	while(size < capacity) {
+		size <<= 1;
+	}
+	m_slots = new _Slot[size];
+	for(size_t i = 0; i < size; ++i) {
+		m_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	m_mask = size - 1;
+	m_head.store(0);
+	m_tail = 0;
+	m_written.store(0);
+	m_dropped.store(0);
+	m_running.store(true);
+	m_thread = std::thread(&LogAsyncSink::run, this);
+}
+
+bool LogAsyncSink::pop() {
+	_Slot *slot = &m_slots[m_tail & m_mask];
+	size_t seq = slot->sequence.load(std::memory_order_acquire);
+	if((intptr_t)seq - (intptr_t)(m_tail+1) < 0) {
+		return false; // empty or still being written
+	}
+	output(slot->level, slot->line, slot->length);
+	slot->sequence.store(m_tail + m_mask + 1, std::memory_order_release);
+	m_tail++;
+	m_written.fetch_add(1, std::memory_order_release);
+	return true;
+}
+
+void LogAsyncSink::output(Level level, const char *line, size_t length) {
+	if(m_callback) {
+		m_callback(level, line, length);
+		return;
+	}
+	int fd = m_fd;
+	if(fd < 0) {
+		fd = (level == LOG_LEVEL_WARN || level == LOG_LEVEL_ERROR ? 2 : 1);
+	}
+	while(length > 0) {
+		int ret = write_fd(fd, line, length);
+		if(ret <= 0) {
+			return;
+		}
+		line += ret;
+		length -= ret;
+	}
+}
+
+void LogAsyncSink::run() {
+	while(true) {
+		if(pop()) {
+			continue;
+		}
+		if(!m_running.load()) {
+			// drain anything written before stopping
+			while(pop()) {}
+			return;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
@@ -0,0 +1,220 @@
+/*==============================================================================
+
+	LogSink.h
+
+	Copyright (C) 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+/// \class LogLevel
+/// \brief log level enum shared by Log & LogSink
+class LogLevel {
+
+	public:
+
+		/// log level enum
+		enum Level {
+			LOG_LEVEL_NORMAL,
+			LOG_LEVEL_DEBUG,
+			LOG_LEVEL_WARN,
+			LOG_LEVEL_ERROR
+		};
+};
+
+/// \class LogSink
+/// \brief destination for finished log lines
+///
+/// the global sink receives every line printed with Log, the default sink
+/// writes to std::cout & std::cerr on the calling thread
+///
+class LogSink : public LogLevel {
+
+	public:
+
+		virtual ~LogSink() {}
+
+		/// write a finished log line, may be called from any thread
+		virtual void write(Level level, const char *line, size_t length) = 0;
+
+		/// set the global sink, does not take ownership,
+		/// set to NULL to restore the default stream sink
+		///
+		/// returns once lines being written to the previous sink by other
+		/// threads are done, so the previous sink can then be destroyed,
+		/// do not call from within a sink's write()
+		static void setSink(LogSink *sink);
+
+		/// get the current global sink, never NULL,
+		/// the sink may be replaced & destroyed by another thread at any time,
+		/// use print() to write to it
+		static LogSink* getSink();
+
+		/// write a line to the current global sink, the sink is not released
+		/// by setSink() or ~LogAsyncSink() while the line is being written
+		static void print(Level level, const char *line, size_t length);
+
+		/// get the line prefix for a level aka "Warn: "
+		static const char* getPrefix(Level level);
+
+		/// set the runtime threshold, lines with a lower severity are discarded
+		/// before any formatting happens, default: LOG_LEVEL_DEBUG (all lines)
+		static void setThreshold(Level level);
+		static Level getThreshold();
+
+		/// severity of a level for threshold checks:
+		/// debug 0, normal 1, warn 2, error 3
+		static inline int getSeverity(Level level) {
+			return (level == LOG_LEVEL_DEBUG ? 0 :
+			       (level == LOG_LEVEL_NORMAL ? 1 : (int)level));
+		}
+
+		/// returns true if a level passes the given compile time minimum
+		/// severity & the runtime threshold
+		static inline bool isEnabled(Level level, int minSeverity) {
+			return getSeverity(level) >= minSeverity &&
+			       getSeverity(level) >= getSeverity(getThreshold());
+		}
+};
+
+/// \class LogLimit
+/// \brief per call site rate limit for repeated log lines
+///
+/// allows a burst of lines per time interval, further lines within the same
+/// interval are suppressed & counted, the count is reported with the next line
+/// which is allowed through
+///
+class LogLimit {
+
+	public:
+
+		/// burst: lines allowed per interval, interval: length in ms
+		LogLimit(unsigned int burst=5, unsigned int interval=1000);
+
+		/// check if a line should be printed,
+		/// returns the number of lines suppressed since the last allowed line
+		/// or -1 if this line should be suppressed
+		long check();
+
+	private:
+
+		unsigned int m_burst; ///< lines allowed per interval
+		long long m_interval; ///< interval length in ms
+		std::atomic<long long> m_start; ///< current interval start time in ms
+		std::atomic<unsigned int> m_count; ///< lines in the current interval
+		std::atomic<long> m_suppressed; ///< suppressed lines since the last allowed line
+};
+
+/// \class LogStreamSink
+/// \brief writes normal & debug lines to std::cout, warnings & errors to std::cerr
+///
+/// this is the default sink, output happens on the calling thread
+///
+class LogStreamSink : public LogSink {
+
+	public:
+
+		void write(Level level, const char *line, size_t length);
+};
+
+/// \class LogAsyncSink
+/// \brief queues log lines & writes them on a background thread
+///
+/// lines are copied into a bounded lock-free ring buffer which is drained by a
+/// background thread, writers never block: lines are dropped & counted when
+/// the buffer is full and lines longer than LINE_SIZE are truncated
+///
+/// output goes to a file descriptor or a user callback, the callback is only
+/// ever called from the background thread
+///
+class LogAsyncSink : public LogSink {
+
+	public:
+
+		/// max line length including prefix, longer lines are truncated
+		static const unsigned int LINE_SIZE = 256;
+
+		/// user output callback
+		typedef std::function<void(Level level, const char *line, size_t length)> Callback;
+
+		/// write to stdout (normal/debug) & stderr (warn/error),
+		/// capacity is the number of queued lines, rounded up to a power of 2
+		LogAsyncSink(unsigned int capacity=1024);
+
+		/// write all lines to the given file descriptor
+		LogAsyncSink(int fd, unsigned int capacity=1024);
+
+		/// pass all lines to the given callback
+		LogAsyncSink(Callback callback, unsigned int capacity=1024);
+
+		/// writes any queued lines & stops the background thread,
+		/// restores the default sink if this is the current global sink &
+		/// waits for lines being queued by other threads through Log,
+		/// lines queued by calling write() directly must be done before
+		virtual ~LogAsyncSink();
+
+		/// queue a line, drops the line if the buffer is full
+		void write(Level level, const char *line, size_t length);
+
+		/// block until all lines queued so far have been written
+		void flush();
+
+		/// number of lines dropped because the buffer was full
+		inline uint64_t getDropped() const {return m_dropped.load(std::memory_order_relaxed);}
+
+	private:
+
+		LogAsyncSink(LogAsyncSink const&);              // not defined, not copyable
+		LogAsyncSink& operator = (LogAsyncSink const&); // not defined, not assignable
+
+		/// ring buffer slot
+		struct _Slot {
+			std::atomic<size_t> sequence; ///< slot sequence number
+			Level level; ///< line level
+			unsigned int length; ///< line length
+			char line[LINE_SIZE]; ///< line text
+		};
+
+		/// allocate the ring buffer & start the background thread
+		void setup(unsigned int capacity);
+
+		/// pop & output a single line, returns false if the buffer is empty
+		bool pop();
+
+		/// output a single line
+		void output(Level level, const char *line, size_t length);
+
+		/// background thread loop
+		void run();
+
+		_Slot *m_slots; ///< ring buffer
+		size_t m_mask; ///< ring buffer size - 1
+		std::atomic<size_t> m_head; ///< next write position
+		size_t m_tail; ///< next read position, background thread only
+		std::atomic<size_t> m_written; ///< number of lines popped
+		std::atomic<uint64_t> m_dropped; ///< number of dropped lines
+		std::atomic<bool> m_running; ///< keep the background thread running?
+
+		int m_fd; ///< file descriptor, -1 for stdout/stderr by level
+		Callback m_callback; ///< user callback, used instead of m_fd if set
+		std::thread m_thread; ///< background thread
+};
@@ -0,0 +1,139 @@
+/*==============================================================================
+
+	Profile.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+// internal profiling & tracing hooks, only compiled in when TINYOBJECT_PROFILE is
+// defined (configure --enable-profile), otherwise all macros are empty
+
+#ifdef TINYOBJECT_PROFILE
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include "XMLObject.h"
+
+namespace tinyxml2 {
+
+/// path & element counters for the current thread, updated by XML
+struct XMLProfileThread {
+	unsigned long pathResolutions;
+	unsigned long siblingSteps;
+	unsigned long elementsCreated;
+};
+extern thread_local XMLProfileThread xmlProfileThread;
+
+/// time & thread counters at a point in time
+class XMLProfileMark {
+
+	public:
+
+		XMLProfileMark() {reset();}
+
+		/// move the mark to now
+		void reset() {
+			m_time = std::chrono::steady_clock::now();
+			m_thread = xmlProfileThread;
+		}
+
+		/// add time & counters since the mark, then move the mark to now
+		void add(XMLProfile::Counters &counters, uint64_t XMLProfile::Counters::*time) {
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			counters.*time += std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_time).count();
+			counters.pathResolutions += xmlProfileThread.pathResolutions - m_thread.pathResolutions;
+			counters.siblingSteps += xmlProfileThread.siblingSteps - m_thread.siblingSteps;
+			counters.elementsCreated += xmlProfileThread.elementsCreated - m_thread.elementsCreated;
+			m_time = now;
+			m_thread = xmlProfileThread;
+		}
+
+		/// add the time since the mark but not the thread counters, then move
+		/// the mark to now, for work done by attached objects which count
+		/// their own paths & elements
+		void skip(XMLProfile::Counters &counters, uint64_t XMLProfile::Counters::*time) {
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			counters.*time += std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_time).count();
+			m_time = now;
+			m_thread = xmlProfileThread;
+		}
+
+	private:
+
+		std::chrono::steady_clock::time_point m_time;
+		XMLProfileThread m_thread;
+};
+
+/// a single trace span, only recorded while XMLTrace is recording,
+/// ends when end() is called or when destroyed
+class XMLTraceSpan {
+
+	public:
+
+		/// name must be a string literal, detail is appended to the name
+		XMLTraceSpan(const char *name, const std::string &detail);
+		~XMLTraceSpan() {end();}
+
+		/// record the span if recording
+		void end();
+
+	private:
+
+		const char *m_name; ///< span name, NULL if not recording
+		std::string m_detail; ///< object name, filename, etc
+		std::chrono::steady_clock::time_point m_start; ///< start time
+};
+
+/// load/save a document like XMLDocument::LoadFile & SaveFile, but reading
+/// & parsing or printing & writing in separate steps, each recorded as its
+/// own trace span, a failed read or write falls back to LoadFile/SaveFile
+/// so the document error is set the same way
+XMLError XMLTraceLoadFile(XMLDocument *doc, const char *filename);
+XMLError XMLTraceSaveFile(XMLDocument *doc, const char *filename);
+
+} // namespace
+
+#define XML_TRACE_BEGIN(span, name, detail) tinyxml2::XMLTraceSpan span(name, detail)
+#define XML_TRACE_END(span) (span).end()
+#define XML_LOAD_FILE(doc, filename) tinyxml2::XMLTraceLoadFile(doc, filename)
+#define XML_SAVE_FILE(doc, filename) tinyxml2::XMLTraceSaveFile(doc, filename)
+#define XML_PROFILE_COUNT(field, n) tinyxml2::xmlProfileThread.field += (n)
+#define XML_PROFILE_MARK(mark) tinyxml2::XMLProfileMark mark
+#define XML_PROFILE_RESET(mark) (mark).reset()
+#define XML_PROFILE_ADD(mark, counters, field) (mark).add(counters, &XMLProfile::Counters::field)
+#define XML_PROFILE_SKIP(mark, counters, field) (mark).skip(counters, &XMLProfile::Counters::field)
+#define XML_PROFILE_CALL(counters) (counters).calls++
+
+#else
+
+#define XML_TRACE_BEGIN(span, name, detail)
+#define XML_TRACE_END(span)
+#define XML_LOAD_FILE(doc, filename) (doc)->LoadFile(filename)
+#define XML_SAVE_FILE(doc, filename) (doc)->SaveFile(filename)
+#define XML_PROFILE_COUNT(field, n)
+#define XML_PROFILE_MARK(mark)
+#define XML_PROFILE_RESET(mark)
+#define XML_PROFILE_ADD(mark, counters, field)
+#define XML_PROFILE_SKIP(mark, counters, field)
+#define XML_PROFILE_CALL(counters)
+
+#endif
@@ -22,129 +22,396 @@
 ==============================================================================*/
 #include "XML.h"
 
+#include "Alloc.h"
+#include "Convert.h"
 #include "Log.h"
+#include "Profile.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <sstream>
 
 namespace tinyxml2 {
 
-// READ
+#ifdef TINYOBJECT_PROFILE
+	thread_local XMLProfileThread xmlProfileThread = {0, 0, 0};
+#endif
 
-bool XML::getTextBool(const XMLElement *element, bool defaultVal) {
+// memory resource of the current thread, NULL for the default resource
+static thread_local std::pmr::memory_resource *xmlMemoryResource = NULL;
+
+// HELPERS
+
+// NUL-terminated copy of a string view for the tinyxml2 functions which take a
+// const char*, short strings are kept on the stack so this does not allocate,
+// long strings are allocated from the thread's memory resource
+class CString {
+
+	public:
+
+		CString(std::string_view s) : m_long(XML::getMemoryResource()) {
+			if(s.size() < sizeof(m_buffer)) {
+				s.copy(m_buffer, s.size());
+				m_buffer[s.size()] = '\0';
+				m_str = m_buffer;
+			}
+			else {
+				m_long.assign(s.data(), s.size());
+				m_str = m_long.c_str();
+			}
+		}
+
+		CString(const CString &from) = delete;
+		CString& operator=(const CString &from) = delete;
+
+		inline operator const char*() const {return m_str;}
+
+	private:
+
+		char m_buffer[64]; ///< short string storage
+		std::pmr::string m_long; ///< long string storage
+		const char *m_str; ///< current string
+};
+
+// reads element names & indices from a path without allocating,
+// see XML::parsePath for the syntax, empty names between slashes are skipped
+class PathReader {
+
+	public:
+
+		typedef CString Name; ///< NUL-terminated element name
+
+		PathReader(std::string_view path) : m_path(path), m_pos(0), m_failed(false) {}
+
+		// read the next element name & index, returns false when done or
+		// if the path is invalid
+		bool next(std::string_view &name, int &index) {
+			name = std::string_view();
+			index = 0;
+			std::string_view token;
+			size_t start = m_pos;
+			while(readToken(token)) {
+				int value = 0;
+				if(std::from_chars(token.data(), token.data()+token.size(), value).ec == std::errc()) {
+					if(name.empty()) { // numeric index
+						LOG_ERROR << "XML: cannot parse path, found index " << token
+						          << " before element name in path: " << m_path << std::endl;
+						m_failed = true;
+						m_pos = m_path.size();
+						return false;
+					}
+					index = value;
+					return true;
+				}
+				if(!name.empty()) { // next element name, read it again next time
+					m_pos = start;
+					return true;
+				}
+				name = token;
+				start = m_pos;
+			}
+			return !name.empty();
+		}
+
+		// returns true if an invalid path was read
+		inline bool failed() const {return m_failed;}
+
+		// returns true if the whole path is valid, logs an error if not
+		static bool check(std::string_view path) {
+			PathReader reader(path);
+			std::string_view name;
+			int index;
+			while(reader.next(name, index)) {}
+			return !reader.failed();
+		}
+
+	private:
+
+		// read the next non-empty token between slashes, returns false when done
+		bool readToken(std::string_view &token) {
+			while(m_pos < m_path.size()) {
+				size_t end = m_path.find('/', m_pos);
+				if(end == std::string_view::npos) {
+					end = m_path.size();
+				}
+				token = m_path.substr(m_pos, end-m_pos);
+				m_pos = (end < m_path.size() ? end+1 : end);
+				if(!token.empty()) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		std::string_view m_path; ///< path to read
+		size_t m_pos; ///< current read position
+		bool m_failed; ///< was an invalid path read?
+};
+
+// reads the element names & indices of a compile-time path,
+// same interface as PathReader
+class NodeReader {
+
+	public:
+
+		// element names are already NUL-terminated, so no copy is needed
+		class Name {
+			public:
+				Name(std::string_view name) : m_str(name.data()) {}
+				inline operator const char*() const {return m_str;}
+			private:
+				const char *m_str; ///< element name
+		};
+
+		NodeReader(const XMLPath &path) : m_path(path), m_pos(0) {}
+
+		// read the next element name & index, returns false when done
+		bool next(std::string_view &name, int &index) {
+			if(m_pos == m_path.size()) {
+				return false;
+			}
+			const XMLPathNode &node = m_path.nodes()[m_pos++];
+			name = node.name;
+			index = node.index;
+			return true;
+		}
+
+		// compile-time paths are always valid
+		inline bool failed() const {return false;}
+
+	private:
+
+		const XMLPath &m_path; ///< path to read
+		size_t m_pos; ///< current node
+};
+
+void XMLPathLiteralError(const char *path, const char *reason) {
+	LOG_ERROR << "XML: invalid path literal \"" << path << "\": " << reason << std::endl;
+}
+
+// TRY READ
+
+// convert element text or an attribute value, NULL if not found
+template<class T> static XMLResult<T> convert(const char *text) {
+	if(text == NULL) {
+		return XMLResult<T>(XML_STATUS_NOT_FOUND);
+	}
+	T value = T();
+	if(!XMLConvert::toValue(text, value)) {
+		return XMLResult<T>(XML_STATUS_WRONG_TYPE);
+	}
+	return XMLResult<T>(value, XML_STATUS_OK);
+}
+
+template<> XMLResult<bool> XML::tryGetText<bool>(const XMLElement *element) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot get text bool, element is NULL" << std::endl;
-		return defaultVal;
+		return XMLResult<bool>(XML_STATUS_NULL_ELEMENT);
 	}
-	bool value = false;
-	int ret = element->QueryBoolText(&value);
-	switch(ret) {
-		case XML_WRONG_ATTRIBUTE_TYPE:
-			LOG_WARN << "XML: cannot get text bool, text value is not of type "
-			         << " bool in element \"" << element->Name()
-			         << "\"" << std::endl;
-			return defaultVal;
-		case XML_NO_ATTRIBUTE:
-			return defaultVal;
-		default: // XML_SUCCESS
-			return value;
+	// will be NULL if there is no text
+	return convert<bool>(element->GetText());
+}
+
+template<> XMLResult<int> XML::tryGetText<int>(const XMLElement *element) {
+	if(element == NULL) {
+		return XMLResult<int>(XML_STATUS_NULL_ELEMENT);
 	}
+	// will be NULL if there is no text
+	return convert<int>(element->GetText());
 }
 
-int XML::getTextInt(const XMLElement *element, int defaultVal) {
+template<> XMLResult<unsigned int> XML::tryGetText<unsigned int>(const XMLElement *element) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot get text int, element is NULL" << std::endl;
-		return defaultVal;
+		return XMLResult<unsigned int>(XML_STATUS_NULL_ELEMENT);
 	}
-	int value = 0;
-	int ret = element->QueryIntText(&value);
-	switch(ret) {
-		case XML_WRONG_ATTRIBUTE_TYPE:
-			LOG_WARN << "XML: cannot get text int, text value is not of type "
-			         << " int in element \"" << element->Name()
-			         << "\"" << std::endl;
-			return defaultVal;
-		case XML_NO_ATTRIBUTE:
-			return defaultVal;
-		default: // XML_SUCCESS
-			return value;
+	// will be NULL if there is no text
+	return convert<unsigned int>(element->GetText());
+}
+
+template<> XMLResult<float> XML::tryGetText<float>(const XMLElement *element) {
+	if(element == NULL) {
+		return XMLResult<float>(XML_STATUS_NULL_ELEMENT);
 	}
+	// will be NULL if there is no text
+	return convert<float>(element->GetText());
 }
 
-unsigned int XML::getTextUInt(const XMLElement *element, unsigned int defaultVal) {
+template<> XMLResult<double> XML::tryGetText<double>(const XMLElement *element) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot get text uint, element is NULL" << std::endl;
-		return defaultVal;
+		return XMLResult<double>(XML_STATUS_NULL_ELEMENT);
 	}
-	unsigned int value = 0;
-	int ret = element->QueryUnsignedText(&value);
-	switch(ret) {
-		case XML_WRONG_ATTRIBUTE_TYPE:
-			LOG_WARN << "XML: cannot get text uint, text value is not of type "
-			         << " uint in element \"" << element->Name()
-			         << "\"" << std::endl;
-			return defaultVal;
-		case XML_NO_ATTRIBUTE:
-			return defaultVal;
-		default: // XML_SUCCESS
-			return value;
+	// will be NULL if there is no text
+	return convert<double>(element->GetText());
+}
+
+template<> XMLResult<const char*> XML::tryGetText<const char*>(const XMLElement *element) {
+	if(element == NULL) {
+		return XMLResult<const char*>(XML_STATUS_NULL_ELEMENT);
+	}
+	// will be NULL if empty
+	const char *text = element->GetText();
+	if(text == NULL) {
+		return XMLResult<const char*>(XML_STATUS_NOT_FOUND);
 	}
+	return XMLResult<const char*>(text, XML_STATUS_OK);
 }
 
-float XML::getTextFloat(const XMLElement *element, float defaultVal) {
+template<> XMLResult<bool> XML::tryGetAttr<bool>(const XMLElement *element, const char *name) {
+	if(element == NULL) {
+		return XMLResult<bool>(XML_STATUS_NULL_ELEMENT);
+	}
+	// will be NULL if attr does not exist
+	return convert<bool>(element->Attribute(name));
+}
+
+template<> XMLResult<int> XML::tryGetAttr<int>(const XMLElement *element, const char *name) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot get text float, element is NULL" << std::endl;
-		return defaultVal;
+		return XMLResult<int>(XML_STATUS_NULL_ELEMENT);
 	}
-	float value = 0;
-	int ret = element->QueryFloatText(&value);
-	switch(ret) {
-		case XML_WRONG_ATTRIBUTE_TYPE:
-			LOG_WARN << "XML: cannot get text float, text value is not of type "
-			         << " double in element \"" << element->Name()
-			         << "\"" << std::endl;
-			return defaultVal;
-		case XML_NO_ATTRIBUTE:
-			return defaultVal;
-		default: // XML_SUCCESS
-			return value;
+	// will be NULL if attr does not exist
+	return convert<int>(element->Attribute(name));
+}
+
+template<> XMLResult<unsigned int> XML::tryGetAttr<unsigned int>(const XMLElement *element, const char *name) {
+	if(element == NULL) {
+		return XMLResult<unsigned int>(XML_STATUS_NULL_ELEMENT);
 	}
+	// will be NULL if attr does not exist
+	return convert<unsigned int>(element->Attribute(name));
 }
 
-double XML::getTextDouble(const XMLElement *element, double defaultVal) {
+template<> XMLResult<float> XML::tryGetAttr<float>(const XMLElement *element, const char *name) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot get text double, element is NULL" << std::endl;
-		return defaultVal;
+		return XMLResult<float>(XML_STATUS_NULL_ELEMENT);
 	}
-	double value = 0;
-	int ret = element->QueryDoubleText(&value);
-	switch(ret) {
-		case XML_WRONG_ATTRIBUTE_TYPE:
-			LOG_WARN << "XML: cannot get text double, text value is not of type "
-			         << " double in element \"" << element->Name()
-			         << "\"" << std::endl;
-			return defaultVal;
-		case XML_NO_ATTRIBUTE:
-			return defaultVal;
-		default: // XML_SUCCESS
-			return value;
+	// will be NULL if attr does not exist
+	return convert<float>(element->Attribute(name));
+}
+
+template<> XMLResult<double> XML::tryGetAttr<double>(const XMLElement *element, const char *name) {
+	if(element == NULL) {
+		return XMLResult<double>(XML_STATUS_NULL_ELEMENT);
 	}
+	// will be NULL if attr does not exist
+	return convert<double>(element->Attribute(name));
 }
 
-std::string XML::getTextString(const XMLElement *element, std::string defaultVal) {
+template<> XMLResult<const char*> XML::tryGetAttr<const char*>(const XMLElement *element, const char *name) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot get text string, element is are NULL" << std::endl;
-		return defaultVal;
+		return XMLResult<const char*>(XML_STATUS_NULL_ELEMENT);
 	}
-	// try to grab value, will be NULL if empty
-	const char *text = element->GetText();
-	if(text == NULL) {
-		return defaultVal;
+	// will be NULL if attr does not exist
+	const char *value = element->Attribute(name);
+	if(value == NULL) {
+		return XMLResult<const char*>(XML_STATUS_NOT_FOUND);
+	}
+	return XMLResult<const char*>(value, XML_STATUS_OK);
+}
+
+// READ
+
+// warn about a failed text read, missing text is not an error
+static void warnText(XMLStatus status, const XMLElement *element, const char *type) {
+	switch(status) {
+		case XML_STATUS_NULL_ELEMENT:
+			LOG_WARN_LIMITED << "XML: cannot get text " << type << ", element is NULL" << std::endl;
+			break;
+		case XML_STATUS_WRONG_TYPE:
+			LOG_WARN_LIMITED << "XML: cannot get text " << type << ", text value is not of type "
+			                 << type << " in element \"" << element->Name()
+			                 << "\"" << std::endl;
+			break;
+		default:
+			break;
 	}
-	return (std::string) text;
+}
+
+// warn about a failed attribute read, a missing attribute is not an error
+static void warnAttr(XMLStatus status, const XMLElement *element, const char *name, const char *type) {
+	switch(status) {
+		case XML_STATUS_NULL_ELEMENT:
+			LOG_WARN_LIMITED << "XML: cannot get attribute " << type << ", element is NULL" << std::endl;
+			break;
+		case XML_STATUS_WRONG_TYPE:
+			LOG_WARN_LIMITED << "XML: cannot get attribute " << type << ", attribute \"" << name
+			                 << "\" is not of type " << type << " in element \"" << element->Name()
+			                 << "\"" << std::endl;
+			break;
+		default:
+			break;
+	}
+}
+
+// type name for warnings
+static const char* typeName(XMLType type) {
+	switch(type) {
+		case XML_TYPE_BOOL:         return "bool";
+		case XML_TYPE_INT:          return "int";
+		case XML_TYPE_UINT:         return "uint";
+		case XML_TYPE_FLOAT:        return "float";
+		case XML_TYPE_DOUBLE:       return "double";
+		case XML_TYPE_STRING:
+		case XML_TYPE_STRING_VIEW:  return "string";
+		case XML_TYPE_INT_ARRAY:    return "int array";
+		case XML_TYPE_FLOAT_ARRAY:  return "float array";
+		case XML_TYPE_DOUBLE_ARRAY: return "double array";
+		default:                    return "undefined";
+	}
+}
+
+void XML::warnTextStatus(XMLStatus status, const XMLElement *element, XMLType type) {
+	warnText(status, element, typeName(type));
+}
+
+void XML::warnAttrStatus(XMLStatus status, const XMLElement *element, std::string_view name, XMLType type) {
+	if(status == XML_STATUS_NULL_ELEMENT || status == XML_STATUS_WRONG_TYPE) { // only copy the name when warning
+		warnAttr(status, element, CString(name), typeName(type));
+	}
+}
+
+bool XML::getTextBool(const XMLElement *element, bool defaultVal) {
+	XMLResult<bool> result = tryGetText<bool>(element);
+	warnText(result.status, element, "bool");
+	return result.valueOr(defaultVal);
+}
+
+int XML::getTextInt(const XMLElement *element, int defaultVal) {
+	XMLResult<int> result = tryGetText<int>(element);
+	warnText(result.status, element, "int");
+	return result.valueOr(defaultVal);
+}
+
+unsigned int XML::getTextUInt(const XMLElement *element, unsigned int defaultVal) {
+	XMLResult<unsigned int> result = tryGetText<unsigned int>(element);
+	warnText(result.status, element, "uint");
+	return result.valueOr(defaultVal);
+}
+
+float XML::getTextFloat(const XMLElement *element, float defaultVal) {
+	XMLResult<float> result = tryGetText<float>(element);
+	warnText(result.status, element, "float");
+	return result.valueOr(defaultVal);
+}
+
+double XML::getTextDouble(const XMLElement *element, double defaultVal) {
+	XMLResult<double> result = tryGetText<double>(element);
+	warnText(result.status, element, "double");
+	return result.valueOr(defaultVal);
+}
+
+std::string XML::getTextString(const XMLElement *element, std::string_view defaultVal) {
+	return std::string(getTextView(element, defaultVal));
+}
+
+std::string_view XML::getTextView(const XMLElement *element, std::string_view defaultVal) {
+	XMLResult<const char*> result = tryGetText<const char*>(element);
+	warnText(result.status, element, "string");
+	return result.ok() ? std::string_view(result.value) : defaultVal;
 }
 
 bool XML::getText(const XMLElement *element, XMLType type, void *var) {
+	XML_ALLOC_SCOPE(XML_ALLOC_GET_VALUE);
 	if(element == NULL || var == NULL) {
-		LOG_WARN << "XML: cannot get text, element and/or variable are NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot get text, element and/or variable are NULL" << std::endl;
 		return false;
 	}
 	int ret = XML_SUCCESS;
@@ -181,8 +448,31 @@ bool XML::getText(const XMLElement *element, XMLType type, void *var) {
 
 		case XML_TYPE_STRING: {
 			std::string *pVar = (std::string*) var;
-			pVar->clear();
-			pVar->append(getTextString(element));
+			pVar->assign(getTextView(element));
+			break;
+		}
+
+		case XML_TYPE_STRING_VIEW: {
+			std::string_view *pVar = (std::string_view*) var;
+			(*pVar) = getTextView(element);
+			break;
+		}
+
+		case XML_TYPE_INT_ARRAY: {
+			std::vector<int> *pVar = (std::vector<int>*) var;
+			getTextArray(element, *pVar);
+			break;
+		}
+
+		case XML_TYPE_FLOAT_ARRAY: {
+			std::vector<float> *pVar = (std::vector<float>*) var;
+			getTextArray(element, *pVar);
+			break;
+		}
+
+		case XML_TYPE_DOUBLE_ARRAY: {
+			std::vector<double> *pVar = (std::vector<double>*) var;
+			getTextArray(element, *pVar);
 			break;
 		}
 		
@@ -192,122 +482,56 @@ bool XML::getText(const XMLElement *element, XMLType type, void *var) {
 	return ret;
 }
 
-bool XML::getAttrBool(const XMLElement *element, std::string name, bool defaultVal) {
-	if(element == NULL) {
-		LOG_WARN << "XML: cannot get attribute bool, element is NULL" << std::endl;
-		return defaultVal;
-	}
-	bool value = false;
-	int ret = element->QueryBoolAttribute(name.c_str(), &value);
-	switch(ret) {
-		case XML_WRONG_ATTRIBUTE_TYPE:
-			LOG_WARN << "XML: cannot get attribute bool, attribute \"" << name
-			         << "\" is not of type bool in element \"" << element->Name()
-			         << "\"" << std::endl;
-			return defaultVal;
-		case XML_NO_ATTRIBUTE:
-			return defaultVal;
-		default: // XML_SUCCESS
-			return (bool) value;
-	}
+bool XML::getAttrBool(const XMLElement *element, std::string_view name, bool defaultVal) {
+	CString cname(name);
+	XMLResult<bool> result = tryGetAttr<bool>(element, cname);
+	warnAttr(result.status, element, cname, "bool");
+	return result.valueOr(defaultVal);
 }
 
-int XML::getAttrInt(const XMLElement *element, std::string name, int defaultVal) {
-	if(element == NULL) {
-		LOG_WARN << "XML: cannot get attr int, element is NULL" << std::endl;
-		return defaultVal;
-	}
-	int value = 0;
-	int ret  = element->QueryIntAttribute(name.c_str(), &value);
-	switch(ret) {
-		case XML_WRONG_ATTRIBUTE_TYPE:
-			LOG_WARN << "XML: cannot get attribute int, attribute \"" << name
-			         << "\" is not of type int in element \"" << element->Name()
-			         << "\"" << std::endl;
-			return defaultVal;
-		case XML_NO_ATTRIBUTE:
-			return defaultVal;
-		default: // XML_SUCCESS
-			return value;
-	}
+int XML::getAttrInt(const XMLElement *element, std::string_view name, int defaultVal) {
+	CString cname(name);
+	XMLResult<int> result = tryGetAttr<int>(element, cname);
+	warnAttr(result.status, element, cname, "int");
+	return result.valueOr(defaultVal);
 }
 
-unsigned int XML::getAttrUInt(const XMLElement *element, std::string name, unsigned int defaultVal) {
-	if(element == NULL) {
-		LOG_WARN << "XML: cannot get attribute uint, element is NULL" << std::endl;
-		return defaultVal;
-	}
-	int value = 0;
-	int ret  = element->QueryIntAttribute(name.c_str(), &value);
-	switch(ret) {
-		case XML_WRONG_ATTRIBUTE_TYPE:
-			LOG_WARN << "XML: cannot get attribute uint, attribute \"" << name
-			         << "\" is not of type int in element \"" << element->Name()
-			         << "\"" << std::endl;
-			return defaultVal;
-		case XML_NO_ATTRIBUTE:
-			return defaultVal;
-		default: // XML_SUCCESS
-			return (unsigned int) value;
-	}
+unsigned int XML::getAttrUInt(const XMLElement *element, std::string_view name, unsigned int defaultVal) {
+	CString cname(name);
+	XMLResult<unsigned int> result = tryGetAttr<unsigned int>(element, cname);
+	warnAttr(result.status, element, cname, "uint");
+	return result.valueOr(defaultVal);
 }
 
-float XML::getAttrFloat(const XMLElement *element, std::string name, float defaultVal) {
-	if(element == NULL) {
-		LOG_WARN << "XML: cannot get attribute float, element is NULL" << std::endl;
-		return defaultVal;
-	}
-	float value = 0;
-	int ret = element->QueryFloatAttribute(name.c_str(), &value);
-	switch(ret) {
-		case XML_WRONG_ATTRIBUTE_TYPE:
-			LOG_WARN << "XML: cannot get attribute float, attribute \"" << name
-			         << "\" is not of type float in element \"" << element->Name()
-			         << "\"" << std::endl;
-			return defaultVal;
-		case XML_NO_ATTRIBUTE:
-			return defaultVal;
-		default: // XML_SUCCESS
-			return value;
-	}
+float XML::getAttrFloat(const XMLElement *element, std::string_view name, float defaultVal) {
+	CString cname(name);
+	XMLResult<float> result = tryGetAttr<float>(element, cname);
+	warnAttr(result.status, element, cname, "float");
+	return result.valueOr(defaultVal);
 }
 
-double XML::getAttrDouble(const XMLElement *element, std::string name, double defaultVal) {
-	if(element == NULL) {
-		LOG_WARN << "XML: cannot get attribute double, element is NULL" << std::endl;
-		return defaultVal;
-	}
-	double value = 0;
-	int ret = element->QueryDoubleAttribute(name.c_str(), &value);
-	switch(ret) {
-		case XML_WRONG_ATTRIBUTE_TYPE:
-			LOG_WARN << "XML: cannot get attribute double: attribute \"" << name
-			         << "\" is not of type double in element \"" << element->Name()
-			         << "\"" << std::endl;
-			return defaultVal;
-		case XML_NO_ATTRIBUTE:
-			return defaultVal;
-		default: // XML_SUCCESS
-			return value;
-	}
+double XML::getAttrDouble(const XMLElement *element, std::string_view name, double defaultVal) {
+	CString cname(name);
+	XMLResult<double> result = tryGetAttr<double>(element, cname);
+	warnAttr(result.status, element, cname, "double");
+	return result.valueOr(defaultVal);
 }
 
-std::string XML::getAttrString(const XMLElement *element, std::string name, std::string defaultVal) {
-	if(element == NULL) {
-		LOG_WARN << "XML: cannot get attribute string, element is are NULL" << std::endl;
-		return defaultVal;
-	}
-	// try to grab value, will be NULL if attr does not exist
-	const char *value = element->Attribute(name.c_str());
-	if(value == NULL) {
-		return defaultVal;
-	}
-	return std::string(value);
+std::string XML::getAttrString(const XMLElement *element, std::string_view name, std::string_view defaultVal) {
+	return std::string(getAttrView(element, name, defaultVal));
+}
+
+std::string_view XML::getAttrView(const XMLElement *element, std::string_view name, std::string_view defaultVal) {
+	CString cname(name);
+	XMLResult<const char*> result = tryGetAttr<const char*>(element, cname);
+	warnAttr(result.status, element, cname, "string");
+	return result.ok() ? std::string_view(result.value) : defaultVal;
 }
 
-bool XML::getAttr(const XMLElement *element, std::string name, XMLType type, void *var) {
+bool XML::getAttr(const XMLElement *element, std::string_view name, XMLType type, void *var) {
+	XML_ALLOC_SCOPE(XML_ALLOC_GET_VALUE);
 	if(element == NULL || var == NULL) {
-		LOG_WARN << "XML: cannot get attribute, element and/or variable are NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot get attribute, element and/or variable are NULL" << std::endl;
 		return false;
 	}
 	int ret = XML_SUCCESS;
@@ -344,8 +568,31 @@ bool XML::getAttr(const XMLElement *element, std::string name, XMLType type, voi
 
 		case XML_TYPE_STRING: {
 			std::string *pVar = (std::string*) var;
-			pVar->clear();
-			pVar->append(getAttrString(element, name));
+			pVar->assign(getAttrView(element, name));
+			break;
+		}
+
+		case XML_TYPE_STRING_VIEW: {
+			std::string_view *pVar = (std::string_view*) var;
+			(*pVar) = getAttrView(element, name);
+			break;
+		}
+
+		case XML_TYPE_INT_ARRAY: {
+			std::vector<int> *pVar = (std::vector<int>*) var;
+			getAttrArray(element, name, *pVar);
+			break;
+		}
+
+		case XML_TYPE_FLOAT_ARRAY: {
+			std::vector<float> *pVar = (std::vector<float>*) var;
+			getAttrArray(element, name, *pVar);
+			break;
+		}
+
+		case XML_TYPE_DOUBLE_ARRAY: {
+			std::vector<double> *pVar = (std::vector<double>*) var;
+			getAttrArray(element, name, *pVar);
 			break;
 		}
 		
@@ -355,7 +602,168 @@ bool XML::getAttr(const XMLElement *element, std::string name, XMLType type, voi
 	return ret;
 }
 
-std::string XML::elementToString(const XMLElement *element, std::string indent) {
+// read an array from element text or an attribute value, NULL if not found
+template<class T> static XMLStatus readArray(const char *text, std::vector<T> &values) {
+	if(text == NULL) { // empty array
+		values.clear();
+		return XML_STATUS_NOT_FOUND;
+	}
+	return XMLConvert::toArray(text, values) ? XML_STATUS_OK : XML_STATUS_WRONG_TYPE;
+}
+
+template<> bool XML::getTextArray<int>(const XMLElement *element, std::vector<int> &values) {
+	XMLStatus status = (element ? readArray(element->GetText(), values) : XML_STATUS_NULL_ELEMENT);
+	warnText(status, element, "int array");
+	return status == XML_STATUS_OK || status == XML_STATUS_NOT_FOUND;
+}
+
+template<> bool XML::getTextArray<float>(const XMLElement *element, std::vector<float> &values) {
+	XMLStatus status = (element ? readArray(element->GetText(), values) : XML_STATUS_NULL_ELEMENT);
+	warnText(status, element, "float array");
+	return status == XML_STATUS_OK || status == XML_STATUS_NOT_FOUND;
+}
+
+template<> bool XML::getTextArray<double>(const XMLElement *element, std::vector<double> &values) {
+	XMLStatus status = (element ? readArray(element->GetText(), values) : XML_STATUS_NULL_ELEMENT);
+	warnText(status, element, "double array");
+	return status == XML_STATUS_OK || status == XML_STATUS_NOT_FOUND;
+}
+
+template<> bool XML::getAttrArray<int>(const XMLElement *element, std::string_view name, std::vector<int> &values) {
+	CString cname(name);
+	XMLStatus status = (element ? readArray(element->Attribute(cname), values) : XML_STATUS_NULL_ELEMENT);
+	warnAttr(status, element, cname, "int array");
+	return status == XML_STATUS_OK || status == XML_STATUS_NOT_FOUND;
+}
+
+template<> bool XML::getAttrArray<float>(const XMLElement *element, std::string_view name, std::vector<float> &values) {
+	CString cname(name);
+	XMLStatus status = (element ? readArray(element->Attribute(cname), values) : XML_STATUS_NULL_ELEMENT);
+	warnAttr(status, element, cname, "float array");
+	return status == XML_STATUS_OK || status == XML_STATUS_NOT_FOUND;
+}
+
+template<> bool XML::getAttrArray<double>(const XMLElement *element, std::string_view name, std::vector<double> &values) {
+	CString cname(name);
+	XMLStatus status = (element ? readArray(element->Attribute(cname), values) : XML_STATUS_NULL_ELEMENT);
+	warnAttr(status, element, cname, "double array");
+	return status == XML_STATUS_OK || status == XML_STATUS_NOT_FOUND;
+}
+
+size_t XML::getAttrs(const XMLElement *element, const std::vector<XMLAttr> &attrs) {
+	XML_ALLOC_SCOPE(XML_ALLOC_GET_VALUE);
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot get attributes, element is NULL" << std::endl;
+		return 0;
+	}
+	XMLAttrIndex index;
+	for(unsigned int i = 0; i < attrs.size(); ++i) {
+		index.add(attrs[i].name);
+	}
+	std::pmr::vector<const char*> values(attrs.size(), NULL, getMemoryResource());
+	size_t found = findAttrs(element, index, values.data());
+	for(unsigned int i = 0; i < attrs.size(); ++i) {
+		convertAttr(element, attrs[i].name, values[i], attrs[i].type, attrs[i].var);
+	}
+	return found;
+}
+
+size_t XML::findAttrs(const XMLElement *element, const XMLAttrIndex &index, const char **values) {
+	std::fill(values, values + index.size(), (const char*)NULL);
+	if(element == NULL) {
+		return 0;
+	}
+	size_t found = 0;
+	const XMLAttribute *attribute = element->FirstAttribute();
+	for(; attribute != NULL && found < index.size(); attribute = attribute->Next()) {
+		// attribute names are unique within an element, so each entry is set once
+		for(int i = index.find(attribute->Name()); i >= 0; i = index.next(i)) {
+			values[i] = attribute->Value();
+			found++;
+		}
+	}
+	return found;
+}
+
+// convert an attribute value into var, the default value if not found or wrong type
+template<class T> static XMLStatus convertAttrValue(const XMLElement *element, std::string_view name,
+                                                    const char *value, T &var, const char *type) {
+	XMLResult<T> result = convert<T>(value);
+	var = result.valueOr(T());
+	if(result.status == XML_STATUS_WRONG_TYPE) { // only copy the name when warning
+		warnAttr(result.status, element, CString(name), type);
+	}
+	return result.status;
+}
+
+// convert an attribute value into an array, empty if not found
+template<class T> static XMLStatus convertAttrArray(const XMLElement *element, std::string_view name,
+                                                    const char *value, std::vector<T> &values, const char *type) {
+	XMLStatus status = readArray(value, values);
+	if(status == XML_STATUS_WRONG_TYPE) {
+		warnAttr(status, element, CString(name), type);
+	}
+	return status;
+}
+
+bool XML::convertAttr(const XMLElement *element, std::string_view name, const char *value, XMLType type, void *var) {
+	if(element == NULL || var == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot get attribute, element and/or variable are NULL" << std::endl;
+		return false;
+	}
+	XMLStatus status = XML_STATUS_OK;
+	switch(type) {
+		case XML_TYPE_BOOL:
+			status = convertAttrValue(element, name, value, *((bool*) var), "bool");
+			break;
+
+		case XML_TYPE_INT:
+			status = convertAttrValue(element, name, value, *((int*) var), "int");
+			break;
+
+		case XML_TYPE_UINT:
+			status = convertAttrValue(element, name, value, *((unsigned int*) var), "uint");
+			break;
+
+		case XML_TYPE_FLOAT:
+			status = convertAttrValue(element, name, value, *((float*) var), "float");
+			break;
+
+		case XML_TYPE_DOUBLE:
+			status = convertAttrValue(element, name, value, *((double*) var), "double");
+			break;
+
+		case XML_TYPE_STRING: {
+			std::string *pVar = (std::string*) var;
+			pVar->assign(value ? value : "");
+			break;
+		}
+
+		case XML_TYPE_STRING_VIEW: {
+			std::string_view *pVar = (std::string_view*) var;
+			(*pVar) = std::string_view(value ? value : "");
+			break;
+		}
+
+		case XML_TYPE_INT_ARRAY:
+			status = convertAttrArray(element, name, value, *((std::vector<int>*) var), "int array");
+			break;
+
+		case XML_TYPE_FLOAT_ARRAY:
+			status = convertAttrArray(element, name, value, *((std::vector<float>*) var), "float array");
+			break;
+
+		case XML_TYPE_DOUBLE_ARRAY:
+			status = convertAttrArray(element, name, value, *((std::vector<double>*) var), "double array");
+			break;
+
+		default:
+			break;
+	}
+	return status != XML_STATUS_WRONG_TYPE;
+}
+
+std::string XML::elementToString(const XMLElement *element, std::string_view indent) {
 	if(element == NULL) {
 		return "";
 	}
@@ -369,32 +777,72 @@ std::string XML::elementToString(const XMLElement *element, std::string indent)
 	return stream.str();
 }
 
-XMLElement* XML::getChild(XMLElement *element, std::string path, int index) {
-	if(element == NULL) {
-		LOG_WARN << "XML: cannot get child, element is NULL" << std::endl;
-		return NULL;
-	}
-	XMLElement *e = element;
-	std::vector<PathNode> nodes = parsePath(path);
-	for(unsigned int n = 0; n < nodes.size(); ++n) {
-		PathNode &node = nodes[n];
-		e = e->FirstChildElement(node.name.c_str());
+// find a child element by the path from a reader, the greater of the last
+// node's index & the index argument is used for the last node
+template<class Reader> static const XMLElement* findChild(const XMLElement *element, Reader &reader, int index) {
+	XML_PROFILE_COUNT(pathResolutions, 1);
+	const XMLElement *e = element;
+	std::string_view name, nextName;
+	int nodeIndex, nextIndex;
+	bool more = reader.next(name, nodeIndex);
+	while(more) {
+		typename Reader::Name cname(name);
+		e = e->FirstChildElement(cname);
 		if(e == NULL) {
 			return NULL;
 		}
-		for(int i = 0; i < node.index; ++i) {
-			e = e->NextSiblingElement(node.name.c_str());
+		more = reader.next(nextName, nextIndex);
+		int num = nodeIndex;
+		if(!more) { // last node
+			num = (index > nodeIndex) ? index : nodeIndex;
+		}
+		for(int i = 0; i < num; ++i) {
+			XML_PROFILE_COUNT(siblingSteps, 1);
+			e = e->NextSiblingElement(cname);
 			if(e == NULL) {
 				return NULL;
 			}
 		}
+		name = nextName;
+		nodeIndex = nextIndex;
+	}
+	if(reader.failed()) { // invalid path is treated as empty
+		return element;
 	}
 	return e;
 }
 
-unsigned int XML::getNumChildren(XMLElement *element, std::string path, std::string name) {
+XMLElement* XML::getChild(XMLElement *element, std::string_view path, int index) {
+	return const_cast<XMLElement*>(getChild((const XMLElement*)element, path, index));
+}
+
+const XMLElement* XML::getChild(const XMLElement *element, std::string_view path, int index) {
+	XML_ALLOC_SCOPE(XML_ALLOC_GET_CHILD);
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot get num children, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot get child, element is NULL" << std::endl;
+		return NULL;
+	}
+	PathReader reader(path);
+	return findChild(element, reader, index);
+}
+
+XMLElement* XML::getChild(XMLElement *element, const XMLPath &path, int index) {
+	return const_cast<XMLElement*>(getChild((const XMLElement*)element, path, index));
+}
+
+const XMLElement* XML::getChild(const XMLElement *element, const XMLPath &path, int index) {
+	XML_ALLOC_SCOPE(XML_ALLOC_GET_CHILD);
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot get child, element is NULL" << std::endl;
+		return NULL;
+	}
+	NodeReader reader(path);
+	return findChild(element, reader, index);
+}
+
+unsigned int XML::getNumChildren(XMLElement *element, std::string_view path, std::string_view name) {
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot get num children, element is NULL" << std::endl;
 		return 0;
 	}
 	unsigned int num = 0;
@@ -409,7 +857,7 @@ unsigned int XML::getNumChildren(XMLElement *element, std::string path, std::str
 	else { // only those with a given name
 		while(e != NULL) {
 			num++;
-			e = e->NextSiblingElement(path.c_str());
+			e = e->NextSiblingElement(CString(path));
 		}
 	}
 	return num;
@@ -419,7 +867,7 @@ unsigned int XML::getNumChildren(XMLElement *element, std::string path, std::str
 
 void XML::setTextBool(XMLElement *element, bool b) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set text bool, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set text bool, element is NULL" << std::endl;
 		return;
 	}
 	element->SetText(b ? "true" : "false");
@@ -427,47 +875,52 @@ void XML::setTextBool(XMLElement *element, bool b) {
 
 void XML::setTextInt(XMLElement *element, int i) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set text int, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set text int, element is NULL" << std::endl;
 		return;
 	}
-	element->SetText(i);
+	char buffer[XMLConvert::TEXT_SIZE];
+	element->SetText(XMLConvert::toText(buffer, i));
 }
 
 void XML::setTextUInt(XMLElement *element, unsigned int i) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set text uint, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set text uint, element is NULL" << std::endl;
 		return;
 	}
-	element->SetText(i);
+	char buffer[XMLConvert::TEXT_SIZE];
+	element->SetText(XMLConvert::toText(buffer, i));
 }
 
 void XML::setTextFloat(XMLElement *element, float f) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set text float, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set text float, element is NULL" << std::endl;
 		return;
 	}
-	element->SetText(f);
+	char buffer[XMLConvert::TEXT_SIZE];
+	element->SetText(XMLConvert::toText(buffer, f));
 }
 
 void XML::setTextDouble(XMLElement *element, double d) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set text double, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set text double, element is NULL" << std::endl;
 		return;
 	}
-	element->SetText(d);
+	char buffer[XMLConvert::TEXT_SIZE];
+	element->SetText(XMLConvert::toText(buffer, d));
 }
 
-void XML::setTextString(XMLElement *element, std::string s) {
+void XML::setTextString(XMLElement *element, std::string_view s) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set text string, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set text string, element is NULL" << std::endl;
 		return;
 	}
-	element->SetText(s.c_str());
+	element->SetText(CString(s));
 }
 
 void XML::setText(XMLElement *element, XMLType type, void *var) {
+	XML_ALLOC_SCOPE(XML_ALLOC_SET_VALUE);
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set text, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set text, element is NULL" << std::endl;
 		return;
 	}
 	
@@ -508,62 +961,92 @@ void XML::setText(XMLElement *element, XMLType type, void *var) {
 			break;
 		}
 
+		case XML_TYPE_STRING_VIEW: {
+			std::string_view *s = (std::string_view*) var;
+			setTextString(element, *s);
+			(*s) = getTextView(element); // the old text may have been freed
+			break;
+		}
+
+		case XML_TYPE_INT_ARRAY: {
+			std::vector<int> *a = (std::vector<int>*) var;
+			setTextArray(element, *a);
+			break;
+		}
+
+		case XML_TYPE_FLOAT_ARRAY: {
+			std::vector<float> *a = (std::vector<float>*) var;
+			setTextArray(element, *a);
+			break;
+		}
+
+		case XML_TYPE_DOUBLE_ARRAY: {
+			std::vector<double> *a = (std::vector<double>*) var;
+			setTextArray(element, *a);
+			break;
+		}
+
 		default:
 			break;
 	}
 }
 
-void XML::setAttrBool(XMLElement *element, std::string name, bool b) {
+void XML::setAttrBool(XMLElement *element, std::string_view name, bool b) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set attribute bool, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set attribute bool, element is NULL" << std::endl;
 		return;
 	}
-	element->SetAttribute(name.c_str(), (b ? "true" : "false"));
+	element->SetAttribute(CString(name), (b ? "true" : "false"));
 }
 
-void XML::setAttrInt(XMLElement *element, std::string name, int i) {
+void XML::setAttrInt(XMLElement *element, std::string_view name, int i) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set attribute int, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set attribute int, element is NULL" << std::endl;
 		return;
 	}
-	element->SetAttribute(name.c_str(), i);
+	char buffer[XMLConvert::TEXT_SIZE];
+	element->SetAttribute(CString(name), XMLConvert::toText(buffer, i));
 }
 
-void XML::setAttrUInt(XMLElement *element, std::string name, unsigned int i) {
+void XML::setAttrUInt(XMLElement *element, std::string_view name, unsigned int i) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set attribute uint, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set attribute uint, element is NULL" << std::endl;
 		return;
 	}
-	element->SetAttribute(name.c_str(), (int) i);
+	char buffer[XMLConvert::TEXT_SIZE];
+	element->SetAttribute(CString(name), XMLConvert::toText(buffer, i));
 }
 
-void XML::setAttrFloat(XMLElement *element, std::string name, float f) {
+void XML::setAttrFloat(XMLElement *element, std::string_view name, float f) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set attribute float, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set attribute float, element is NULL" << std::endl;
 		return;
 	}
-	element->SetAttribute(name.c_str(), f);
+	char buffer[XMLConvert::TEXT_SIZE];
+	element->SetAttribute(CString(name), XMLConvert::toText(buffer, f));
 }
 
-void XML::setAttrDouble(XMLElement *element, std::string name, double d) {
+void XML::setAttrDouble(XMLElement *element, std::string_view name, double d) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set attribute double, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set attribute double, element is NULL" << std::endl;
 		return;
 	}
-	element->SetAttribute(name.c_str(), d);
+	char buffer[XMLConvert::TEXT_SIZE];
+	element->SetAttribute(CString(name), XMLConvert::toText(buffer, d));
 }
 
-void XML::setAttrString(XMLElement *element, std::string name, std::string s) {
+void XML::setAttrString(XMLElement *element, std::string_view name, std::string_view s) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot set attribute string(), element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set attribute string(), element is NULL" << std::endl;
 		return;
 	}
-	element->SetAttribute(name.c_str(), s.c_str());
+	element->SetAttribute(CString(name), CString(s));
 }
 
-void XML::setAttr(XMLElement *element, std::string name, XMLType type, void *var) {
+void XML::setAttr(XMLElement *element, std::string_view name, XMLType type, void *var) {
+	XML_ALLOC_SCOPE(XML_ALLOC_SET_VALUE);
 	if(element == NULL || var == NULL) {
-		LOG_WARN << "XML: cannot set attribute, element and/or variable are NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot set attribute, element and/or variable are NULL" << std::endl;
 		return;
 	}
 	switch(type) {
@@ -603,77 +1086,515 @@ void XML::setAttr(XMLElement *element, std::string name, XMLType type, void *var
 			break;
 		}
 
+		case XML_TYPE_STRING_VIEW: {
+			std::string_view *s = (std::string_view*) var;
+			setAttrString(element, name, *s);
+			(*s) = getAttrView(element, name); // the old value may have been freed
+			break;
+		}
+
+		case XML_TYPE_INT_ARRAY: {
+			std::vector<int> *a = (std::vector<int>*) var;
+			setAttrArray(element, name, *a);
+			break;
+		}
+
+		case XML_TYPE_FLOAT_ARRAY: {
+			std::vector<float> *a = (std::vector<float>*) var;
+			setAttrArray(element, name, *a);
+			break;
+		}
+
+		case XML_TYPE_DOUBLE_ARRAY: {
+			std::vector<double> *a = (std::vector<double>*) var;
+			setAttrArray(element, name, *a);
+			break;
+		}
+
 		default:
 			break;
 	}
 }
 
-XMLElement* XML::addChild(XMLElement *element, std::string path, int index) {
+// array text buffer, reused to avoid allocating on every save
+static thread_local std::string s_arrayText;
+
+template<> void XML::setTextArray<int>(XMLElement *element, const std::vector<int> &values) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot add child, element is NULL" << std::endl;
-		return NULL;
+		LOG_WARN_LIMITED << "XML: cannot set text int array, element is NULL" << std::endl;
+		return;
 	}
-	XMLElement *child = element;
-	std::vector<PathNode> nodes = parsePath(path);
-	for(unsigned int n = 0; n < nodes.size(); ++n) {
-		PathNode &node = nodes[n];
-		if(n < nodes.size()-1) { // preceeding nodes
-			child = XML::obtainChild(child, node.name, node.index);
-		}
-		else { // last node
-			XMLElement *e = element->GetDocument()->NewElement(node.name.c_str());
-			XMLElement *sibling = obtainChild(child, node.name, (index > node.index ? index-1 : node.index-1));
-			if(sibling) { // last node exists/was created, so insert before
-				child->InsertAfterChild(sibling, e);
-			}
-			else {
-				child->InsertEndChild(e);
-			}
-			child = e;
-		}
+	XMLConvert::toArrayText(values, s_arrayText);
+	element->SetText(s_arrayText.c_str());
+}
+
+template<> void XML::setTextArray<float>(XMLElement *element, const std::vector<float> &values) {
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot set text float array, element is NULL" << std::endl;
+		return;
 	}
-	return child;
+	XMLConvert::toArrayText(values, s_arrayText);
+	element->SetText(s_arrayText.c_str());
 }
 
-XMLElement* XML::obtainChild(XMLElement *element, std::string path, int index) {
+template<> void XML::setTextArray<double>(XMLElement *element, const std::vector<double> &values) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot obtain child, element is NULL" << std::endl;
-		return NULL;
+		LOG_WARN_LIMITED << "XML: cannot set text double array, element is NULL" << std::endl;
+		return;
+	}
+	XMLConvert::toArrayText(values, s_arrayText);
+	element->SetText(s_arrayText.c_str());
+}
+
+template<> void XML::setAttrArray<int>(XMLElement *element, std::string_view name, const std::vector<int> &values) {
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot set attribute int array, element is NULL" << std::endl;
+		return;
+	}
+	XMLConvert::toArrayText(values, s_arrayText);
+	element->SetAttribute(CString(name), s_arrayText.c_str());
+}
+
+template<> void XML::setAttrArray<float>(XMLElement *element, std::string_view name, const std::vector<float> &values) {
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot set attribute float array, element is NULL" << std::endl;
+		return;
+	}
+	XMLConvert::toArrayText(values, s_arrayText);
+	element->SetAttribute(CString(name), s_arrayText.c_str());
+}
+
+template<> void XML::setAttrArray<double>(XMLElement *element, std::string_view name, const std::vector<double> &values) {
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot set attribute double array, element is NULL" << std::endl;
+		return;
+	}
+	XMLConvert::toArrayText(values, s_arrayText);
+	element->SetAttribute(CString(name), s_arrayText.c_str());
+}
+
+// add a child element by the path from a valid reader
+template<class Reader> static XMLElement* addChildPath(XMLElement *element, Reader &reader, int index) {
+	XMLElement *child = element;
+	std::string_view name, nextName;
+	int nodeIndex, nextIndex;
+	if(!reader.next(name, nodeIndex)) {
+		return child;
+	}
+	while(reader.next(nextName, nextIndex)) { // preceeding nodes
+		child = XML::obtainChild(child, name, nodeIndex);
+		name = nextName;
+		nodeIndex = nextIndex;
+	}
+
+	// last node
+	XML_PROFILE_COUNT(elementsCreated, 1);
+	XMLElement *e = element->GetDocument()->NewElement(typename Reader::Name(name));
+	XMLElement *sibling = XML::obtainChild(child, name, (index > nodeIndex ? index-1 : nodeIndex-1));
+	if(sibling) { // last node exists/was created, so insert before
+		child->InsertAfterChild(sibling, e);
+	}
+	else {
+		child->InsertEndChild(e);
 	}
+	return e;
+}
+
+// find or create a child element by the path from a valid reader
+template<class Reader> static XMLElement* obtainChildPath(XMLElement *element, Reader &reader, int index) {
+	XML_PROFILE_COUNT(pathResolutions, 1);
 	XMLElement *child = element;
-	std::vector<PathNode> nodes = parsePath(path);
-	for(unsigned int n = 0; n < nodes.size(); ++n) {
-		PathNode &node = nodes[n];
-		XMLElement *e = child->FirstChildElement(node.name.c_str());
+	std::string_view name, nextName;
+	int nodeIndex, nextIndex;
+	bool more = reader.next(name, nodeIndex);
+	while(more) {
+		typename Reader::Name cname(name);
+		XMLElement *e = child->FirstChildElement(cname);
 		if(e == NULL) {
-			e = element->GetDocument()->NewElement(node.name.c_str());
+			XML_PROFILE_COUNT(elementsCreated, 1);
+			e = element->GetDocument()->NewElement(cname);
 			child->InsertEndChild(e);
 		}
-		int num = node.index;
-		if(n == nodes.size()-1) {
-			num = (index > node.index) ? index : node.index;
+		more = reader.next(nextName, nextIndex);
+		int num = nodeIndex;
+		if(!more) { // last node
+			num = (index > nodeIndex) ? index : nodeIndex;
 		}
 		for(int i = 0; i < num; ++i) {
-			e = e->NextSiblingElement(node.name.c_str());
+			XML_PROFILE_COUNT(siblingSteps, 1);
+			e = e->NextSiblingElement(cname);
 			if(e == NULL) {
-				e = element->GetDocument()->NewElement(node.name.c_str());
+				XML_PROFILE_COUNT(elementsCreated, 1);
+				e = element->GetDocument()->NewElement(cname);
 				child->InsertEndChild(e);
 			}
 		}
 		child = e;
+		name = nextName;
+		nodeIndex = nextIndex;
 	}
 	return child;
 }
 
-void XML::addComment(XMLElement *element, std::string comment) {
+XMLElement* XML::addChild(XMLElement *element, std::string_view path, int index) {
+	XML_ALLOC_SCOPE(XML_ALLOC_ADD_CHILD);
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot add child, element is NULL" << std::endl;
+		return NULL;
+	}
+	if(!PathReader::check(path)) { // invalid path is treated as empty
+		return element;
+	}
+	PathReader reader(path);
+	return addChildPath(element, reader, index);
+}
+
+XMLElement* XML::addChild(XMLElement *element, const XMLPath &path, int index) {
+	XML_ALLOC_SCOPE(XML_ALLOC_ADD_CHILD);
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot add child, element is NULL" << std::endl;
+		return NULL;
+	}
+	NodeReader reader(path);
+	return addChildPath(element, reader, index);
+}
+
+XMLElement* XML::obtainChild(XMLElement *element, std::string_view path, int index) {
+	XML_ALLOC_SCOPE(XML_ALLOC_OBTAIN_CHILD);
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot obtain child, element is NULL" << std::endl;
+		return NULL;
+	}
+	if(!PathReader::check(path)) { // invalid path is treated as empty
+		XML_PROFILE_COUNT(pathResolutions, 1);
+		return element;
+	}
+	PathReader reader(path);
+	return obtainChildPath(element, reader, index);
+}
+
+XMLElement* XML::obtainChild(XMLElement *element, const XMLPath &path, int index) {
+	XML_ALLOC_SCOPE(XML_ALLOC_OBTAIN_CHILD);
+	if(element == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot obtain child, element is NULL" << std::endl;
+		return NULL;
+	}
+	NodeReader reader(path);
+	return obtainChildPath(element, reader, index);
+}
+
+void XML::addComment(XMLElement *element, std::string_view comment) {
 	if(element == NULL) {
-		LOG_WARN << "XML: cannot add comment, element is NULL" << std::endl;
+		LOG_WARN_LIMITED << "XML: cannot add comment, element is NULL" << std::endl;
 		return;
 	}
-	XMLComment *child = element->GetDocument()->NewComment(comment.c_str());
+	XMLComment *child = element->GetDocument()->NewComment(CString(comment));
 	element->InsertEndChild(child);
 }
 
+// ATTRIBUTE INDEX
+
+// FNV-1a hash of a name
+static inline size_t hashName(std::string_view name) {
+	uint64_t hash = 14695981039346656037ULL;
+	for(size_t i = 0; i < name.size(); ++i) {
+		hash = (hash ^ (unsigned char)name[i]) * 1099511628211ULL;
+	}
+	return hash;
+}
+
+// FNV-1a hash of a NUL-terminated name, also gets the length so the name is read once
+static inline size_t hashName(const char *name, size_t &length) {
+	uint64_t hash = 14695981039346656037ULL;
+	const char *p = name;
+	for(; *p != '\0'; ++p) {
+		hash = (hash ^ (unsigned char)*p) * 1099511628211ULL;
+	}
+	length = p - name;
+	return hash;
+}
+
+XMLAttrIndex::XMLAttrIndex(std::pmr::memory_resource *resource) :
+	m_names(resource ? resource : XML::getMemoryResource()),
+	m_entries(resource ? resource : XML::getMemoryResource()),
+	m_slots(resource ? resource : XML::getMemoryResource()) {}
+
+int XMLAttrIndex::add(std::string_view name) {
+	size_t hash = hashName(name);
+	int first = find(name.data(), name.size(), hash);
+	int index = (int)m_entries.size();
+	_Entry entry = {hash, m_names.size(), name.size(), -1};
+	m_names.append(name.data(), name.size());
+	m_entries.push_back(entry);
+	if(first >= 0) { // chain repeated names, only the first is in the table
+		while(m_entries[first].next >= 0) {
+			first = m_entries[first].next;
+		}
+		m_entries[first].next = index;
+		return index;
+	}
+	if(m_entries.size() * 2 > m_slots.size()) { // keep the table at most half full
+		rehash(m_slots.empty() ? 8 : m_slots.size() * 2);
+		return index;
+	}
+	size_t mask = m_slots.size() - 1;
+	size_t slot = hash & mask;
+	while(m_slots[slot] >= 0) {
+		slot = (slot + 1) & mask;
+	}
+	m_slots[slot] = index;
+	return index;
+}
+
+void XMLAttrIndex::clear() {
+	m_names.clear();
+	m_entries.clear();
+	std::fill(m_slots.begin(), m_slots.end(), -1);
+}
+
+int XMLAttrIndex::find(const char *name) const {
+	size_t length = 0;
+	size_t hash = hashName(name, length);
+	return find(name, length, hash);
+}
+
+int XMLAttrIndex::find(const char *name, size_t length, size_t hash) const {
+	if(m_slots.empty()) {
+		return -1;
+	}
+	size_t mask = m_slots.size() - 1;
+	for(size_t slot = hash & mask; m_slots[slot] >= 0; slot = (slot + 1) & mask) {
+		const _Entry &entry = m_entries[m_slots[slot]];
+		if(entry.hash == hash && entry.length == length &&
+		   !memcmp(m_names.data() + entry.offset, name, length)) {
+			return m_slots[slot];
+		}
+	}
+	return -1;
+}
+
+void XMLAttrIndex::rehash(size_t size) {
+	m_slots.assign(size, -1);
+	size_t mask = size - 1;
+	for(size_t i = 0; i < m_entries.size(); ++i) {
+		const _Entry &entry = m_entries[i];
+		// chained entries come after the first entry with their name
+		if(find(m_names.data() + entry.offset, entry.length, entry.hash) >= 0) {
+			continue;
+		}
+		size_t slot = entry.hash & mask;
+		while(m_slots[slot] >= 0) {
+			slot = (slot + 1) & mask;
+		}
+		m_slots[slot] = (int)i;
+	}
+}
+
+// COLUMNS
+
+// columns read from the same element below a record
+struct ColumnGroup {
+	std::string_view path; ///< element path relative to the record
+	int text; ///< element text column or -1
+	std::vector<int> attributes; ///< attribute columns
+	size_t next; ///< attribute column to try first, records are usually the same shape
+};
+
+// convert & append a record value to a column, text is NULL if not found
+static void appendColumn(XMLColumn &column, size_t row, const char *text) {
+	bool ok = (text != NULL);
+	switch(column.type) {
+		case XML_TYPE_BOOL: {
+			bool value = false;
+			ok = ok && XMLConvert::toValue(text, value);
+			column.bools.push_back(ok && value);
+			break;
+		}
+		case XML_TYPE_INT: {
+			int value = 0;
+			ok = ok && XMLConvert::toValue(text, value);
+			column.ints.push_back(ok ? value : 0);
+			break;
+		}
+		case XML_TYPE_UINT: {
+			unsigned int value = 0;
+			ok = ok && XMLConvert::toValue(text, value);
+			column.uints.push_back(ok ? value : 0);
+			break;
+		}
+		case XML_TYPE_FLOAT: {
+			float value = 0;
+			ok = ok && XMLConvert::toValue(text, value);
+			column.floats.push_back(ok ? value : 0);
+			break;
+		}
+		case XML_TYPE_DOUBLE: {
+			double value = 0;
+			ok = ok && XMLConvert::toValue(text, value);
+			column.doubles.push_back(ok ? value : 0);
+			break;
+		}
+		case XML_TYPE_STRING:
+		case XML_TYPE_STRING_VIEW:
+			if(ok) {
+				column.arena.append(text);
+			}
+			column.offsets.push_back(column.arena.size());
+			break;
+		default: // rejected by getColumns
+			ok = false;
+			break;
+	}
+	if(ok && column.nullable) {
+		column.valid[row/8] |= (1 << (row%8));
+	}
+}
+
+// can values of a type be extracted into a column?
+static bool isColumnType(XMLType type) {
+	switch(type) {
+		case XML_TYPE_BOOL:
+		case XML_TYPE_INT:
+		case XML_TYPE_UINT:
+		case XML_TYPE_FLOAT:
+		case XML_TYPE_DOUBLE:
+		case XML_TYPE_STRING:
+		case XML_TYPE_STRING_VIEW:
+			return true;
+		default:
+			return false;
+	}
+}
+
+// reserve column storage for a number of records
+static void reserveColumn(XMLColumn &column, size_t records) {
+	switch(column.type) {
+		case XML_TYPE_BOOL:
+			column.bools.reserve(records);
+			break;
+		case XML_TYPE_INT:
+			column.ints.reserve(records);
+			break;
+		case XML_TYPE_UINT:
+			column.uints.reserve(records);
+			break;
+		case XML_TYPE_FLOAT:
+			column.floats.reserve(records);
+			break;
+		case XML_TYPE_DOUBLE:
+			column.doubles.reserve(records);
+			break;
+		case XML_TYPE_STRING:
+		case XML_TYPE_STRING_VIEW:
+			column.offsets.reserve(records+1);
+			column.offsets.push_back(0);
+			break;
+		default:
+			break;
+	}
+	if(column.nullable) {
+		column.valid.assign((records+7)/8, 0);
+	}
+}
+
+size_t XML::getColumns(const XMLElement *parent, std::string_view record, std::vector<XMLColumn> &columns) {
+	if(parent == NULL) {
+		LOG_WARN_LIMITED << "XML: cannot get columns, parent element is NULL" << std::endl;
+		return 0;
+	}
+	CString crecord(record);
+
+	// count records to allocate the columns once
+	size_t records = 0;
+	const XMLElement *e = parent->FirstChildElement(crecord);
+	for(; e != NULL; e = e->NextSiblingElement(crecord)) {
+		records++;
+	}
+	std::vector<bool> supported(columns.size());
+	for(unsigned int c = 0; c < columns.size(); ++c) {
+		columns[c].clear();
+		supported[c] = isColumnType(columns[c].type);
+		if(!supported[c]) {
+			LOG_WARN_LIMITED << "XML: cannot get column \"" << columns[c].path << "\" \""
+			                 << columns[c].name << "\", type is not supported, skipping" << std::endl;
+			continue;
+		}
+		reserveColumn(columns[c], records);
+	}
+
+	// group columns by element so each element is found & its attributes
+	// are walked once per record
+	std::vector<ColumnGroup> groups;
+	for(unsigned int c = 0; c < columns.size(); ++c) {
+		if(!supported[c]) {
+			continue;
+		}
+		unsigned int g = 0;
+		while(g < groups.size() && groups[g].path != columns[c].path) {
+			g++;
+		}
+		if(g == groups.size()) {
+			ColumnGroup group = {columns[c].path, -1, std::vector<int>(), 0};
+			groups.push_back(group);
+		}
+		if(columns[c].name.empty()) {
+			groups[g].text = c;
+		}
+		else {
+			groups[g].attributes.push_back(c);
+		}
+	}
+
+	// extract
+	std::vector<const char*> texts(columns.size());
+	size_t row = 0;
+	for(e = parent->FirstChildElement(crecord); e != NULL; e = e->NextSiblingElement(crecord), ++row) {
+		std::fill(texts.begin(), texts.end(), (const char*)NULL);
+		for(unsigned int g = 0; g < groups.size(); ++g) {
+			ColumnGroup &group = groups[g];
+			const XMLElement *element = (group.path.empty() ? e : getChild(e, group.path));
+			if(element == NULL) {
+				continue;
+			}
+			if(group.text >= 0) {
+				texts[group.text] = element->GetText();
+			}
+			if(group.attributes.empty()) {
+				continue;
+			}
+			const XMLAttribute *attribute = element->FirstAttribute();
+			for(; attribute != NULL; attribute = attribute->Next()) {
+				size_t num = group.attributes.size();
+				for(size_t a = 0; a < num; ++a) {
+					size_t i = (group.next + a) % num;
+					int c = group.attributes[i];
+					if(!strcmp(attribute->Name(), columns[c].name.c_str())) {
+						texts[c] = attribute->Value();
+						group.next = i+1;
+						break;
+					}
+				}
+			}
+		}
+		for(unsigned int c = 0; c < columns.size(); ++c) {
+			if(supported[c]) {
+				appendColumn(columns[c], row, texts[c]);
+			}
+		}
+	}
+	return records;
+}
+
+// MEMORY
+
+void XML::setMemoryResource(std::pmr::memory_resource *resource) {
+	xmlMemoryResource = resource;
+}
+
+std::pmr::memory_resource* XML::getMemoryResource() {
+	return xmlMemoryResource ? xmlMemoryResource : std::pmr::get_default_resource();
+}
+
 // UTIL
 
 std::string XML::getErrorString(const XMLDocument *xmlDoc) {
@@ -690,37 +1611,19 @@ std::string XML::getErrorString(const XMLDocument *xmlDoc) {
 	return error.str();
 }
 
-// numeric check via stringstream:
-// http://stackoverflow.com/questions/4917265/can-i-tell-if-a-stdstring-represents-a-number-using-stringstream
-std::vector<XML::PathNode> XML::parsePath(std::string path) {
+std::vector<XML::PathNode> XML::parsePath(std::string_view path) {
+	XML_ALLOC_SCOPE(XML_ALLOC_PARSE_PATH);
 	std::vector<XML::PathNode> nodes;
 	XML::PathNode node;
-	std::istringstream line(path);
-	std::string token;
-	while(std::getline(line, token, '/')) {
-		std::stringstream numeric(token);
-		int index = 0;
-		if(numeric >> index) { // numeric index
-			if(node.name == "") {
-				LOG_ERROR << "XML: cannot parse path, found index " << token
-				          << " before element name in path: " << path << std::endl;
-				return std::vector<XML::PathNode>(); // empty
-			}
-			node.index = index;
-			nodes.push_back(node);
-			node.clear();
-		}
-		else { // element name
-			if(node.name != "") { // push previous
-				nodes.push_back(node);
-				node.clear();
-			}
-			node.name = token;
-		}
-	}
-	if(node.name != "") { // push anything left over
+	PathReader reader(path);
+	std::string_view name;
+	while(reader.next(name, node.index)) {
+		node.name.assign(name.data(), name.size());
 		nodes.push_back(node);
 	}
+	if(reader.failed()) {
+		return std::vector<XML::PathNode>(); // empty
+	}
 	return nodes;
 }
 
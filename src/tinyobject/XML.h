@@ -23,8 +23,11 @@
 #pragma once
 
 #include <tinyxml2.h>
+#include "XMLPath.h"
 #include <stdint.h>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace tinyxml2 {
@@ -37,7 +40,163 @@ enum XMLType {
 	XML_TYPE_UINT,
 	XML_TYPE_FLOAT,
 	XML_TYPE_DOUBLE,
-	XML_TYPE_STRING
+	XML_TYPE_STRING,
+	XML_TYPE_INT_ARRAY,    ///< std::vector<int>
+	XML_TYPE_FLOAT_ARRAY,  ///< std::vector<float>
+	XML_TYPE_DOUBLE_ARRAY, ///< std::vector<double>
+	XML_TYPE_STRING_VIEW   ///< std::string_view into the document text, see XMLStringArena
+};
+
+/// maps a variable type to its XMLType enum, XML_TYPE_UNDEF if not supported
+template<class T> struct XMLTypeOf {static const XMLType type = XML_TYPE_UNDEF;};
+template<> struct XMLTypeOf<bool> {static const XMLType type = XML_TYPE_BOOL;};
+template<> struct XMLTypeOf<int> {static const XMLType type = XML_TYPE_INT;};
+template<> struct XMLTypeOf<unsigned int> {static const XMLType type = XML_TYPE_UINT;};
+template<> struct XMLTypeOf<float> {static const XMLType type = XML_TYPE_FLOAT;};
+template<> struct XMLTypeOf<double> {static const XMLType type = XML_TYPE_DOUBLE;};
+template<> struct XMLTypeOf<std::string> {static const XMLType type = XML_TYPE_STRING;};
+template<> struct XMLTypeOf<std::vector<int>> {static const XMLType type = XML_TYPE_INT_ARRAY;};
+template<> struct XMLTypeOf<std::vector<float>> {static const XMLType type = XML_TYPE_FLOAT_ARRAY;};
+template<> struct XMLTypeOf<std::vector<double>> {static const XMLType type = XML_TYPE_DOUBLE_ARRAY;};
+template<> struct XMLTypeOf<std::string_view> {static const XMLType type = XML_TYPE_STRING_VIEW;};
+
+/// status of a value read with the XML::tryGet* functions
+enum XMLStatus {
+	XML_STATUS_OK = 0,       ///< value found & converted
+	XML_STATUS_NULL_ELEMENT, ///< element is NULL
+	XML_STATUS_NOT_FOUND,    ///< element has no text or attribute not found
+	XML_STATUS_WRONG_TYPE    ///< text or attribute could not be converted
+};
+
+/// value & status returned by the XML::tryGet* functions,
+/// value is only valid if status is XML_STATUS_OK
+template<class T> struct XMLResult {
+
+	T value; ///< converted value
+	XMLStatus status; ///< read status
+
+	XMLResult(XMLStatus status=XML_STATUS_NOT_FOUND) : value(), status(status) {}
+	XMLResult(T value, XMLStatus status) : value(value), status(status) {}
+
+	/// was the value found & converted?
+	inline bool ok() const {return status == XML_STATUS_OK;}
+
+	/// returns value on success or defaultVal otherwise
+	inline T valueOr(T defaultVal) const {return ok() ? value : defaultVal;}
+};
+
+/// a column of values extracted from repeated records by XML::getColumns
+struct XMLColumn {
+
+	std::string path; ///< element path relative to the record, empty for the record itself
+	std::string name; ///< attribute name, empty for the element text
+	XMLType type; ///< bool, int, uint, float, double, string or string view
+	bool nullable; ///< fill the valid bitmap?
+
+	/// extracted values, only the vector matching the type is filled,
+	/// records without a valid value get 0
+	std::vector<uint8_t> bools;
+	std::vector<int> ints;
+	std::vector<unsigned int> uints;
+	std::vector<float> floats;
+	std::vector<double> doubles;
+
+	/// extracted strings, string i is [offsets[i], offsets[i+1]) in the arena,
+	/// records without a value get an empty string
+	std::string arena;
+	std::vector<size_t> offsets;
+
+	/// valid bitmap when nullable, bit i%8 of byte i/8 is set if record i
+	/// had a value which could be converted to the type
+	std::vector<uint8_t> valid;
+
+	XMLColumn(std::string_view path, std::string_view name, XMLType type, bool nullable=false) :
+		path(path), name(name), type(type), nullable(nullable) {}
+
+	/// did record i have a valid value? always true if not nullable
+	inline bool isValid(size_t i) const {
+		return !nullable || (i/8 < valid.size() && (valid[i/8] & (1 << (i%8))));
+	}
+
+	/// get string i as a view into the arena
+	inline std::string_view getString(size_t i) const {
+		return std::string_view(arena.data() + offsets[i], offsets[i+1] - offsets[i]);
+	}
+
+	/// clear extracted values, keeps the allocated capacity
+	void clear() {
+		bools.clear();
+		ints.clear();
+		uints.clear();
+		floats.clear();
+		doubles.clear();
+		arena.clear();
+		offsets.clear();
+		valid.clear();
+	}
+};
+
+/// an attribute to read into a variable by XML::getAttrs
+struct XMLAttr {
+
+	std::string_view name; ///< attribute name
+	XMLType type; ///< value type
+	void *var; ///< pointer to the variable to read into
+
+	XMLAttr(std::string_view name, XMLType type, void *var) :
+		name(name), type(type), var(var) {}
+};
+
+/// \class XMLAttrIndex
+/// \brief hashed set of attribute names for reading many attributes at once
+///
+/// names are added once, ie. when subscribing, & numbered in order so each
+/// attribute of an element is matched with a single hash & compare while
+/// walking its attributes instead of looking up every name in turn
+///
+class XMLAttrIndex {
+
+	public:
+
+		/// NULL uses XML::getMemoryResource()
+		XMLAttrIndex(std::pmr::memory_resource *resource=NULL);
+
+		/// add a name & return its number, a repeated name is chained to the
+		/// previous entry with the same name
+		int add(std::string_view name);
+
+		/// remove all names, keeps the allocated capacity
+		void clear();
+
+		/// number of names
+		inline size_t size() const {return m_entries.size();}
+
+		/// find a name, returns the number of the first entry with that name
+		/// or -1 if not found
+		int find(const char *name) const;
+
+		/// returns the number of the next entry with the same name or -1
+		inline int next(int index) const {return m_entries[index].next;}
+
+	private:
+
+		/// indexed name
+		struct _Entry {
+			size_t hash; ///< name hash
+			size_t offset; ///< name start in m_names
+			size_t length; ///< name length
+			int next; ///< next entry with the same name or -1
+		};
+
+		/// find a name with a given hash
+		int find(const char *name, size_t length, size_t hash) const;
+
+		/// grow the slot table & re-insert the first entry of each name
+		void rehash(size_t size);
+
+		std::pmr::string m_names; ///< indexed names, back to back
+		std::pmr::vector<_Entry> m_entries; ///< entries in the order added
+		std::pmr::vector<int> m_slots; ///< open addressing table of entries, -1 if empty
 };
 
 /// \class XML
@@ -46,6 +205,22 @@ class XML {
 
 	public:
 
+	/// \section Try Read
+	/// these do not log and report why a value could not be read,
+	/// supported types: bool, int, unsigned int, float, double & const char*,
+	/// a const char* value points into the document
+
+		/// element text access by type
+		template<class T> static XMLResult<T> tryGetText(const XMLElement *element);
+
+		/// element attribute access by type
+		template<class T> static XMLResult<T> tryGetAttr(const XMLElement *element, const char *name);
+
+		/// log why a value could not be read like the Read functions do,
+		/// nothing is logged for XML_STATUS_OK & XML_STATUS_NOT_FOUND
+		static void warnTextStatus(XMLStatus status, const XMLElement *element, XMLType type);
+		static void warnAttrStatus(XMLStatus status, const XMLElement *element, std::string_view name, XMLType type);
+
 	/// \section Read
 
 		/// element text access by type,
@@ -55,38 +230,77 @@ class XML {
 		static unsigned int getTextUInt(const XMLElement *element, unsigned int defaultVal=0);
 		static float getTextFloat(const XMLElement *element, float defaultVal=0.0f);
 		static double getTextDouble(const XMLElement *element, double defaultVal=0.0);
-		static std::string getTextString(const XMLElement *element, std::string defaultVal="");
+		static std::string getTextString(const XMLElement *element, std::string_view defaultVal="");
+
+		/// element text as a view into the document, does not allocate,
+		/// the view is valid until the element is changed or the document closed
+		static std::string_view getTextView(const XMLElement *element, std::string_view defaultVal="");
 
 		/// element text access using type enum
 		static bool getText(const XMLElement *element, XMLType type, void *var);
 	
 		/// element attribute access by type
 		/// returns value on success or defaultVal if attribute not found or wrong type
-		static bool getAttrBool(const XMLElement *element, std::string name, bool defaultVal=false);
-		static int getAttrInt(const XMLElement *element, std::string name, int defaultVal=0);
-		static unsigned int getAttrUInt(const XMLElement *element, std::string name, unsigned int defaultVal=0);
-		static float getAttrFloat(const XMLElement *element, std::string name, float defaultVal=0.0f);
-		static double getAttrDouble(const XMLElement *element, std::string name, double defaultVal=0.0);
-		static std::string getAttrString(const XMLElement *element, std::string name, std::string defaultVal="");
+		static bool getAttrBool(const XMLElement *element, std::string_view name, bool defaultVal=false);
+		static int getAttrInt(const XMLElement *element, std::string_view name, int defaultVal=0);
+		static unsigned int getAttrUInt(const XMLElement *element, std::string_view name, unsigned int defaultVal=0);
+		static float getAttrFloat(const XMLElement *element, std::string_view name, float defaultVal=0.0f);
+		static double getAttrDouble(const XMLElement *element, std::string_view name, double defaultVal=0.0);
+		static std::string getAttrString(const XMLElement *element, std::string_view name, std::string_view defaultVal="");
+
+		/// element attribute as a view into the document, does not allocate,
+		/// the view is valid until the element is changed or the document closed
+		static std::string_view getAttrView(const XMLElement *element, std::string_view name, std::string_view defaultVal="");
 		
+		/// element text or attribute as an array of numbers separated by
+		/// whitespace and/or commas, supported types: int, float & double
+		/// values is cleared & then filled, missing text or attribute is an
+		/// empty array, returns false if a value is not a number
+		template<class T> static bool getTextArray(const XMLElement *element, std::vector<T> &values);
+		template<class T> static bool getAttrArray(const XMLElement *element, std::string_view name, std::vector<T> &values);
+
 		/// element attribute access using type enum, returns true on success
-		static bool getAttr(const XMLElement *element, std::string name, XMLType type, void *var);
-	
+		static bool getAttr(const XMLElement *element, std::string_view name, XMLType type, void *var);
+
+		/// read many attributes in a single walk over the element's
+		/// attributes, each is read like getAttr(element, name, type, var) so a
+		/// missing attribute gets the default value, returns the number found
+		///
+		/// builds an index of the names for each call, keep an XMLAttrIndex &
+		/// use findAttrs & convertAttr to read the same names repeatedly
+		static size_t getAttrs(const XMLElement *element, const std::vector<XMLAttr> &attrs);
+
+		/// find the values of indexed attribute names in a single walk over the
+		/// element's attributes, values[i] is set to the value of name i or NULL
+		/// if not found, values must have room for index.size() pointers,
+		/// returns the number found
+		static size_t findAttrs(const XMLElement *element, const XMLAttrIndex &index, const char **values);
+
+		/// read an attribute value found by findAttrs into a variable like
+		/// getAttr, value is NULL if the attribute was not found
+		static bool convertAttr(const XMLElement *element, std::string_view name, const char *value,
+		                        XMLType type, void *var);
+
 		/// return element and attributes as a string, does not descend to children
-		static std::string elementToString(const XMLElement *element, std::string indent);
+		static std::string elementToString(const XMLElement *element, std::string_view indent);
 
 		/// find child element by path and index (if in a list), returns NULL if element not found
 		/// path can also be a / separated string to denote multiple levels of depth below the given
 		/// element aka "/sub/element/test" or "/sub/1/element/2/test"
 		/// if an index is given for the final element in the path along with an index argument, the greater of
 		/// the two is used
-		static XMLElement* getChild(XMLElement *element, std::string path, int index=0);
+		static XMLElement* getChild(XMLElement *element, std::string_view path, int index=0);
+		static const XMLElement* getChild(const XMLElement *element, std::string_view path, int index=0);
+
+		/// find child element by a path split at compile time, ie. XML_PATH("sub/1/element")
+		static XMLElement* getChild(XMLElement *element, const XMLPath &path, int index=0);
+		static const XMLElement* getChild(const XMLElement *element, const XMLPath &path, int index=0);
 	
 		/// get the number of child elements with the given name,
 		/// if name is empty "", returns total number of child elements
 		/// path can also be a / separated string to denote multiple levels of depth below the given
 		/// element aka "sub/element/test" or "/sub/1/element/2/test"
-		static unsigned int getNumChildren(XMLElement *element, std::string path="", std::string name="");
+		static unsigned int getNumChildren(XMLElement *element, std::string_view path="", std::string_view name="");
 
 	/// \section Write
 
@@ -96,21 +310,29 @@ class XML {
 		static void setTextUInt(XMLElement *element, unsigned int i);
 		static void setTextFloat(XMLElement *element, float f);
 		static void setTextDouble(XMLElement *element, double d);
-		static void setTextString(XMLElement *element, std::string s);
+		static void setTextString(XMLElement *element, std::string_view s);
 
-		/// set the element text using type enum
+		/// set the element text using type enum, an XML_TYPE_STRING_VIEW
+		/// variable is re-pointed to the new text as setting it frees the
+		/// text the view may point into
 		static void setText(XMLElement *element, XMLType type, void *var);
 
 		/// set element attributes by type
-		static void setAttrBool(XMLElement *element, std::string name, bool b);
-		static void setAttrInt(XMLElement *element, std::string name, int i);
-		static void setAttrUInt(XMLElement *element, std::string name, unsigned int i);
-		static void setAttrFloat(XMLElement *element, std::string name, float f);
-		static void setAttrDouble(XMLElement *element, std::string name, double d);
-		static void setAttrString(XMLElement *element, std::string name, std::string s);
-
-		/// set attribute using XMLObject type enum
-		static void setAttr(XMLElement *element, std::string name, XMLType type, void *var);
+		static void setAttrBool(XMLElement *element, std::string_view name, bool b);
+		static void setAttrInt(XMLElement *element, std::string_view name, int i);
+		static void setAttrUInt(XMLElement *element, std::string_view name, unsigned int i);
+		static void setAttrFloat(XMLElement *element, std::string_view name, float f);
+		static void setAttrDouble(XMLElement *element, std::string_view name, double d);
+		static void setAttrString(XMLElement *element, std::string_view name, std::string_view s);
+
+		/// set the element text or attribute to an array of numbers separated
+		/// by spaces, supported types: int, float & double
+		template<class T> static void setTextArray(XMLElement *element, const std::vector<T> &values);
+		template<class T> static void setAttrArray(XMLElement *element, std::string_view name, const std::vector<T> &values);
+
+		/// set attribute using XMLObject type enum, an XML_TYPE_STRING_VIEW
+		/// variable is re-pointed to the new value like setText()
+		static void setAttr(XMLElement *element, std::string_view name, XMLType type, void *var);
 	
 		/// adds a child element at a specific index in a list of same elements (0 for first),
 		/// adds to end if index is invalid
@@ -118,7 +340,8 @@ class XML {
 		/// element aka "sub/element/test" or "/sub/1/element/2/test"
 		/// if an index is given for the final element in the path along with an index argument, the greater of
 		/// the two is used
-		static XMLElement* addChild(XMLElement *element, std::string path, int index=0);
+		static XMLElement* addChild(XMLElement *element, std::string_view path, int index=0);
+		static XMLElement* addChild(XMLElement *element, const XMLPath &path, int index=0);
 	
 		/// finds child element at specific index in a list of same elements (0 for first),
 		/// creates and adds to end if not found
@@ -126,10 +349,37 @@ class XML {
 		/// element aka "sub/element/test" or "/sub/1/element/2/test"
 		/// if an index is given for the final element in the path along with an index argument, the greater of
 		/// the two is used
-		static XMLElement* obtainChild(XMLElement *element, std::string path, int index=0);
+		static XMLElement* obtainChild(XMLElement *element, std::string_view path, int index=0);
+		static XMLElement* obtainChild(XMLElement *element, const XMLPath &path, int index=0);
 
 		/// adds a comment as a child of the given element
-		static void addComment(XMLElement *element, std::string comment);
+		static void addComment(XMLElement *element, std::string_view comment);
+
+	/// \section Columns
+
+		/// extract values from repeated record elements into typed columns in
+		/// a single pass, records are the children of parent with the given
+		/// element name, ie. record "object" & columns (path "", name "name",
+		/// XML_TYPE_STRING) & (path "bar", name "", XML_TYPE_FLOAT) for
+		/// <object name="einstein"><bar>3.14159</bar></object>...
+		///
+		/// columns are cleared first & keep their capacity, each attribute is
+		/// looked up once per record element by walking its attributes,
+		/// columns of other types, ie. arrays, are skipped with a warning &
+		/// stay empty, returns the number of records
+		static size_t getColumns(const XMLElement *parent, std::string_view record,
+		                         std::vector<XMLColumn> &columns);
+
+	/// \section Memory
+
+		/// set the memory resource for library-internal allocations on the
+		/// calling thread, ie. long path names & XMLObject temporaries, & the
+		/// default for XMLObjects constructed on this thread without one,
+		/// NULL restores std::pmr::get_default_resource()
+		static void setMemoryResource(std::pmr::memory_resource *resource);
+
+		/// get the memory resource of the calling thread
+		static std::pmr::memory_resource* getMemoryResource();
 
 	/// \section Util
 
@@ -164,8 +414,71 @@ class XML {
 		/// an index before an element name string results in an error:
 		///    "1/foo/bar" -> error
 		///
-		/// used internally as a "poor man's XPath"
-		static std::vector<PathNode> parsePath(std::string path);
+		/// used internally as a "poor man's XPath", the path functions read the
+		/// path in place & do not allocate
+		static std::vector<PathNode> parsePath(std::string_view path);
 };
 
+/// \class XMLMemoryScope
+/// \brief sets the memory resource of the calling thread for its lifetime
+///
+/// the previous resource is restored when the scope ends, a NULL resource
+/// keeps the current one
+///
+class XMLMemoryScope {
+
+	public:
+
+		XMLMemoryScope(std::pmr::memory_resource *resource) :
+			m_previous(XML::getMemoryResource()), m_set(resource != NULL) {
+			if(m_set) {
+				XML::setMemoryResource(resource);
+			}
+		}
+
+		~XMLMemoryScope() {
+			if(m_set) {
+				XML::setMemoryResource(m_previous);
+			}
+		}
+
+		XMLMemoryScope(const XMLMemoryScope &from) = delete;
+		XMLMemoryScope& operator=(const XMLMemoryScope &from) = delete;
+
+	private:
+
+		std::pmr::memory_resource *m_previous; ///< resource to restore
+		bool m_set; ///< was a resource set?
+};
+
+// supported XML::tryGetText & XML::tryGetAttr types, defined in XML.cpp
+template<> XMLResult<bool> XML::tryGetText<bool>(const XMLElement *element);
+template<> XMLResult<int> XML::tryGetText<int>(const XMLElement *element);
+template<> XMLResult<unsigned int> XML::tryGetText<unsigned int>(const XMLElement *element);
+template<> XMLResult<float> XML::tryGetText<float>(const XMLElement *element);
+template<> XMLResult<double> XML::tryGetText<double>(const XMLElement *element);
+template<> XMLResult<const char*> XML::tryGetText<const char*>(const XMLElement *element);
+template<> XMLResult<bool> XML::tryGetAttr<bool>(const XMLElement *element, const char *name);
+template<> XMLResult<int> XML::tryGetAttr<int>(const XMLElement *element, const char *name);
+template<> XMLResult<unsigned int> XML::tryGetAttr<unsigned int>(const XMLElement *element, const char *name);
+template<> XMLResult<float> XML::tryGetAttr<float>(const XMLElement *element, const char *name);
+template<> XMLResult<double> XML::tryGetAttr<double>(const XMLElement *element, const char *name);
+template<> XMLResult<const char*> XML::tryGetAttr<const char*>(const XMLElement *element, const char *name);
+
+
+// supported XML::getTextArray, getAttrArray, setTextArray & setAttrArray types,
+// defined in XML.cpp
+template<> bool XML::getTextArray<int>(const XMLElement *element, std::vector<int> &values);
+template<> bool XML::getTextArray<float>(const XMLElement *element, std::vector<float> &values);
+template<> bool XML::getTextArray<double>(const XMLElement *element, std::vector<double> &values);
+template<> bool XML::getAttrArray<int>(const XMLElement *element, std::string_view name, std::vector<int> &values);
+template<> bool XML::getAttrArray<float>(const XMLElement *element, std::string_view name, std::vector<float> &values);
+template<> bool XML::getAttrArray<double>(const XMLElement *element, std::string_view name, std::vector<double> &values);
+template<> void XML::setTextArray<int>(XMLElement *element, const std::vector<int> &values);
+template<> void XML::setTextArray<float>(XMLElement *element, const std::vector<float> &values);
+template<> void XML::setTextArray<double>(XMLElement *element, const std::vector<double> &values);
+template<> void XML::setAttrArray<int>(XMLElement *element, std::string_view name, const std::vector<int> &values);
+template<> void XML::setAttrArray<float>(XMLElement *element, std::string_view name, const std::vector<float> &values);
+template<> void XML::setAttrArray<double>(XMLElement *element, std::string_view name, const std::vector<double> &values);
+
 } // namespace
@@ -0,0 +1,209 @@
+/*==============================================================================
+
+	XMLAlloc.cpp
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#include "XMLAlloc.h"
+
+#include "Alloc.h"
+
+namespace tinyxml2 {
+
+static const char *s_names[XML_ALLOC_NUM_ENTRIES] = {
+	"other",
+	"loadXMLFile",
+	"loadXML",
+	"saveXMLFile",
+	"saveXML",
+	"getChild",
+	"obtainChild",
+	"addChild",
+	"parsePath",
+	"getValue",
+	"setValue"
+};
+
+const char* XMLAlloc::getName(XMLAllocEntry entry) {
+	if(entry < 0 || entry >= XML_ALLOC_NUM_ENTRIES) {
+		return "";
+	}
+	return s_names[entry];
+}
+
+} // namespace
+
+#ifdef TINYOBJECT_ALLOC_COUNT
+
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+
+namespace tinyxml2 {
+
+// counters, zero initialized before any dynamic initialization so they are
+// usable from allocations during static init
+static std::atomic<uint64_t> s_counts[XML_ALLOC_NUM_ENTRIES];
+static std::atomic<uint64_t> s_bytes[XML_ALLOC_NUM_ENTRIES];
+
+// bitmask of the entry points the current thread is inside of
+static thread_local uint32_t s_entries = 0;
+
+// count an allocation for all active entry points
+static void count(size_t size) {
+	uint32_t entries = s_entries;
+	if(entries == 0) {
+		s_counts[XML_ALLOC_OTHER].fetch_add(1, std::memory_order_relaxed);
+		s_bytes[XML_ALLOC_OTHER].fetch_add(size, std::memory_order_relaxed);
+		return;
+	}
+	for(int i = 1; i < XML_ALLOC_NUM_ENTRIES; ++i) {
+		if(entries & (1u << i)) {
+			s_counts[i].fetch_add(1, std::memory_order_relaxed);
+			s_bytes[i].fetch_add(size, std::memory_order_relaxed);
+		}
+	}
+}
+
+// XML ALLOC SCOPE
+
+XMLAllocScope::XMLAllocScope(XMLAllocEntry entry) : m_previous(s_entries) {
+	s_entries |= (1u << entry);
+}
+
+XMLAllocScope::~XMLAllocScope() {
+	s_entries = m_previous;
+}
+
+// XML ALLOC
+
+bool XMLAlloc::isEnabled() {
+	return true;
+}
+
+uint64_t XMLAlloc::getCount(XMLAllocEntry entry) {
+	if(entry < 0 || entry >= XML_ALLOC_NUM_ENTRIES) {
+		return 0;
+	}
+	return s_counts[entry].load();
+}
+
+uint64_t XMLAlloc::getBytes(XMLAllocEntry entry) {
+	if(entry < 0 || entry >= XML_ALLOC_NUM_ENTRIES) {
+		return 0;
+	}
+	return s_bytes[entry].load();
+}
+
+void XMLAlloc::reset() {
+	for(int i = 0; i < XML_ALLOC_NUM_ENTRIES; ++i) {
+		s_counts[i].store(0);
+		s_bytes[i].store(0);
+	}
+}
+
+} // namespace
+
+// replacement global allocation functions, the nothrow versions call these by
+// default so they are counted as well, this includes the aligned forms used
+// for over-aligned types
+
+void* operator new(size_t size) {
+	tinyxml2::count(size);
+	void *p = malloc(size ? size : 1);
+	if(p == NULL) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void *p) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p) noexcept {
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept {
+	free(p);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+	tinyxml2::count(size);
+	void *p = NULL;
+	size_t align = (size_t)alignment;
+	if(align < sizeof(void*)) { // posix_memalign minimum
+		align = sizeof(void*);
+	}
+	if(posix_memalign(&p, align, size ? size : 1) != 0) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+	return operator new(size, alignment);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept {
+	free(p);
+}
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept {
+	free(p);
+}
+
+void operator delete[](void *p, size_t, std::align_val_t) noexcept {
+	free(p);
+}
+
+#else
+
+namespace tinyxml2 {
+
+bool XMLAlloc::isEnabled() {
+	return false;
+}
+
+uint64_t XMLAlloc::getCount(XMLAllocEntry) {
+	return 0;
+}
+
+uint64_t XMLAlloc::getBytes(XMLAllocEntry) {
+	return 0;
+}
+
+void XMLAlloc::reset() {}
+
+} // namespace
+
+#endif
@@ -0,0 +1,75 @@
+/*==============================================================================
+
+	XMLAlloc.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include <stdint.h>
+
+namespace tinyxml2 {
+
+/// library entry points for allocation accounting
+enum XMLAllocEntry {
+	XML_ALLOC_OTHER = 0,      ///< outside of any entry point
+	XML_ALLOC_LOAD_XML_FILE,  ///< XMLObject::loadXMLFile
+	XML_ALLOC_LOAD_XML,       ///< XMLObject::loadXML
+	XML_ALLOC_SAVE_XML_FILE,  ///< XMLObject::saveXMLFile
+	XML_ALLOC_SAVE_XML,       ///< XMLObject::saveXML
+	XML_ALLOC_GET_CHILD,      ///< XML::getChild
+	XML_ALLOC_OBTAIN_CHILD,   ///< XML::obtainChild
+	XML_ALLOC_ADD_CHILD,      ///< XML::addChild
+	XML_ALLOC_PARSE_PATH,     ///< XML::parsePath
+	XML_ALLOC_GET_VALUE,      ///< XML::getText & XML::getAttr
+	XML_ALLOC_SET_VALUE,      ///< XML::setText & XML::setAttr
+	XML_ALLOC_NUM_ENTRIES
+};
+
+/// \class XMLAlloc
+/// \brief allocation counters per library entry point
+///
+/// when the library is built with TINYOBJECT_ALLOC_COUNT defined
+/// (configure --enable-alloc-count), it replaces the global operator new &
+/// delete to count allocations while inside each entry point, counts are
+/// inclusive: an allocation in getChild called by loadXML counts for both
+///
+/// allocations outside of any entry point are counted as XML_ALLOC_OTHER
+///
+class XMLAlloc {
+
+	public:
+
+		/// returns true if allocation counting is compiled in
+		static bool isEnabled();
+
+		/// number of allocations within an entry point since the last reset
+		static uint64_t getCount(XMLAllocEntry entry);
+
+		/// number of bytes allocated within an entry point since the last reset
+		static uint64_t getBytes(XMLAllocEntry entry);
+
+		/// reset all counters to 0
+		static void reset();
+
+		/// get the name of an entry point aka "loadXML"
+		static const char* getName(XMLAllocEntry entry);
+};
+
+} // namespace
@@ -0,0 +1,71 @@
+/*==============================================================================
+
+	XMLBinding.cpp
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#include "XMLBinding.h"
+
+#include <algorithm>
+
+namespace tinyxml2 {
+
+XMLBindings::XMLBindings(std::initializer_list<XMLBinding> bindings) {
+	m_bindings.reserve(bindings.size());
+
+	// add bindings group by group, keeping the declaration order within a group
+	std::vector<bool> added(bindings.size(), false);
+	const XMLBinding *list = bindings.begin();
+	for(size_t i = 0; i < bindings.size(); ++i) {
+		if(added[i]) {
+			continue;
+		}
+		Group group;
+		group.path = list[i].path;
+		group.begin = m_bindings.size();
+		for(size_t j = i; j < bindings.size(); ++j) {
+			if(added[j] || list[j].path != group.path) {
+				continue;
+			}
+			m_bindings.push_back(list[j]);
+			added[j] = true;
+		}
+		group.end = m_bindings.size();
+		m_groups.push_back(group);
+	}
+
+	// the members of a class share the same check, so only check each class once
+	for(size_t i = 0; i < m_bindings.size(); ++i) {
+		bool (*check)(const XMLObject*) = m_bindings[i].isMemberOf;
+		if(std::find(m_classChecks.begin(), m_classChecks.end(), check) == m_classChecks.end()) {
+			m_classChecks.push_back(check);
+		}
+	}
+}
+
+bool XMLBindings::isBindable(const XMLObject *object) const {
+	for(size_t i = 0; i < m_classChecks.size(); ++i) {
+		if(!m_classChecks[i](object)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
@@ -0,0 +1,149 @@
+/*==============================================================================
+
+	XMLBinding.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include "XML.h"
+#include <initializer_list>
+#include <type_traits>
+
+namespace tinyxml2 {
+
+class XMLObject;
+
+/// member pointer class & value types
+template<class M> struct XMLMember;
+template<class C, class T> struct XMLMember<T C::*> {
+	typedef C Class;
+	typedef T Type;
+};
+
+/// \class XMLBinding
+/// \brief an element or attribute subscription declared via a member pointer
+///
+/// bindings are declared once per class & collected in an XMLBindings table,
+/// ie. for a float member "number":
+///
+///     XMLBinding::element<&MyObject::number>("subelement/test/number")
+///
+/// the member type selects the XMLType, see XMLTypeOf
+///
+struct XMLBinding {
+
+	std::string path; ///< element path, empty for the object's element
+	std::string name; ///< attribute name, empty for the element text
+	XMLType type; ///< value type
+	bool readOnly; ///< should this value be written when saving?
+	void* (*var)(XMLObject *object); ///< get the member variable of an object
+	bool (*isMemberOf)(const XMLObject *object); ///< is the object of the member's class? same for all members of a class
+
+	/// bind a member to the text of the element at a path
+	template<auto member> static XMLBinding element(std::string_view path, bool readOnly=false) {
+		return XMLBinding(path, "", XMLTypeOf<typename XMLMember<decltype(member)>::Type>::type,
+		                  readOnly, &memberVar<member>, &memberOf<typename XMLMember<decltype(member)>::Class>);
+	}
+
+	/// bind a member to an attribute in the element at a path,
+	/// leave the path empty "" for the object's element
+	template<auto member> static XMLBinding attribute(std::string_view path, std::string_view name, bool readOnly=false) {
+		return XMLBinding(path, name, XMLTypeOf<typename XMLMember<decltype(member)>::Type>::type,
+		                  readOnly, &memberVar<member>, &memberOf<typename XMLMember<decltype(member)>::Class>);
+	}
+
+	private:
+
+		XMLBinding(std::string_view path, std::string_view name, XMLType type,
+		           bool readOnly, void* (*var)(XMLObject*), bool (*isMemberOf)(const XMLObject*)) :
+			path(path), name(name), type(type), readOnly(readOnly), var(var), isMemberOf(isMemberOf) {}
+
+		/// get the member variable of an object of the member's class,
+		/// the class is checked by XMLObject::setXMLBindings()
+		template<auto member> static void* memberVar(XMLObject *object) {
+			typedef typename XMLMember<decltype(member)>::Class Class;
+			static_assert(std::is_base_of<XMLObject, Class>::value,
+			              "member must belong to an XMLObject subclass");
+			static_assert(XMLTypeOf<typename XMLMember<decltype(member)>::Type>::type != XML_TYPE_UNDEF,
+			              "unsupported member type");
+			return &(static_cast<Class*>(object)->*member);
+		}
+
+		/// returns true if an object is of a class or derived from it,
+		/// templated on the class so all members of a class share one check
+		template<class Class> static bool memberOf(const XMLObject *object) {
+			return dynamic_cast<const Class*>(object) != NULL;
+		}
+};
+
+/// \class XMLBindings
+/// \brief an immutable table of bindings shared by all objects of a class
+///
+/// subscribing in the constructor allocates the same subscription nodes &
+/// path strings for every object, a table is built once instead & objects
+/// only keep a pointer to it:
+///
+///     static const XMLBindings& bindings() {
+///         static const XMLBindings table({
+///             XMLBinding::attribute<&MyObject::name>("", "name"),
+///             XMLBinding::element<&MyObject::number>("subelement/test/number")
+///         });
+///         return table;
+///     }
+///
+///     MyObject() : XMLObject("myobject") {setXMLBindings(&bindings());}
+///
+/// bindings are grouped by element path, so each element is found once per
+/// load or save
+///
+class XMLBindings {
+
+	public:
+
+		/// bindings with the same path
+		struct Group {
+			std::string path; ///< element path, empty for the object's element
+			size_t begin; ///< first binding
+			size_t end; ///< one past the last binding
+		};
+
+		XMLBindings(std::initializer_list<XMLBinding> bindings);
+
+		/// get a binding by index, in group order
+		inline const XMLBinding& at(size_t i) const {return m_bindings[i];}
+
+		/// number of bindings
+		inline size_t size() const {return m_bindings.size();}
+
+		/// bindings grouped by element path, in the order the paths were first declared
+		inline const std::vector<Group>& getGroups() const {return m_groups;}
+
+		/// returns true if every bound member belongs to the object's class
+		/// or one of its bases, ie. the table can be used with the object
+		bool isBindable(const XMLObject *object) const;
+
+	private:
+
+		std::vector<XMLBinding> m_bindings; ///< bindings sorted by group
+		std::vector<Group> m_groups; ///< binding groups
+		std::vector<bool (*)(const XMLObject*)> m_classChecks; ///< one per member class
+};
+
+} // namespace
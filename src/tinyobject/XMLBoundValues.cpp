@@ -0,0 +1,154 @@
+/*==============================================================================
+
+	XMLBoundValues.cpp
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#include "XMLBoundValues.h"
+
+#include <algorithm>
+
+namespace tinyxml2 {
+
+// sort by variable address
+static bool valueLess(const void *a, const void *b) {
+	return std::less<const void*>()(a, b);
+}
+
+bool XMLBoundValues::get(const void *var, XMLType type, void *value) const {
+	const _Value *v = find(var);
+	if(v == NULL || v->type != type || value == NULL) {
+		return false;
+	}
+	switch(type) {
+		case XML_TYPE_BOOL:
+			*((bool*) value) = v->num.b;
+			return true;
+		case XML_TYPE_INT:
+			*((int*) value) = v->num.i;
+			return true;
+		case XML_TYPE_UINT:
+			*((unsigned int*) value) = v->num.ui;
+			return true;
+		case XML_TYPE_FLOAT:
+			*((float*) value) = v->num.f;
+			return true;
+		case XML_TYPE_DOUBLE:
+			*((double*) value) = v->num.d;
+			return true;
+		case XML_TYPE_STRING:
+			*((std::string*) value) = v->s;
+			return true;
+		case XML_TYPE_INT_ARRAY:
+			*((std::vector<int>*) value) = v->ints;
+			return true;
+		case XML_TYPE_FLOAT_ARRAY:
+			*((std::vector<float>*) value) = v->floats;
+			return true;
+		case XML_TYPE_DOUBLE_ARRAY:
+			*((std::vector<double>*) value) = v->doubles;
+			return true;
+		case XML_TYPE_STRING_VIEW:
+			*((std::string_view*) value) = v->view;
+			return true;
+		default:
+			return false;
+	}
+}
+
+void XMLBoundValues::apply() const {
+	for(unsigned int i = 0; i < m_values.size(); ++i) {
+		const _Value &v = m_values[i];
+		get(v.var, v.type, const_cast<void*>(v.var));
+	}
+}
+
+// PRIVATE
+
+void* XMLBoundValues::add(const void *var, XMLType type) {
+	m_values.push_back(_Value());
+	_Value &v = m_values.back();
+	v.var = var;
+	v.type = type;
+	v.num.d = 0;
+	switch(type) {
+		case XML_TYPE_BOOL:
+			return &v.num.b;
+		case XML_TYPE_INT:
+			return &v.num.i;
+		case XML_TYPE_UINT:
+			return &v.num.ui;
+		case XML_TYPE_FLOAT:
+			return &v.num.f;
+		case XML_TYPE_DOUBLE:
+			return &v.num.d;
+		case XML_TYPE_STRING:
+			return &v.s;
+		case XML_TYPE_INT_ARRAY:
+			return &v.ints;
+		case XML_TYPE_FLOAT_ARRAY:
+			return &v.floats;
+		case XML_TYPE_DOUBLE_ARRAY:
+			return &v.doubles;
+		case XML_TYPE_STRING_VIEW:
+			return &v.view;
+		default:
+			return NULL;
+	}
+}
+
+void XMLBoundValues::finish(unsigned long sequence) {
+	m_sequence = sequence;
+
+	// stable sort keeps the load order within the same variable
+	std::stable_sort(m_values.begin(), m_values.end(),
+		[](const _Value &a, const _Value &b) {return valueLess(a.var, b.var);});
+
+	// keep the last value loaded into each variable
+	std::vector<_Value> unique;
+	unique.reserve(m_values.size());
+	for(unsigned int i = 0; i < m_values.size(); ++i) {
+		if(i+1 < m_values.size() && m_values[i+1].var == m_values[i].var) {
+			continue;
+		}
+		unique.push_back(std::move(m_values[i]));
+	}
+	m_values.swap(unique);
+
+	// views point into the document, take a copy now the values don't move anymore
+	for(unsigned int i = 0; i < m_values.size(); ++i) {
+		_Value &v = m_values[i];
+		if(v.type == XML_TYPE_STRING_VIEW) {
+			v.s.assign(v.view);
+			v.view = v.s;
+		}
+	}
+}
+
+const XMLBoundValues::_Value* XMLBoundValues::find(const void *var) const {
+	std::vector<_Value>::const_iterator iter = std::lower_bound(
+		m_values.begin(), m_values.end(), var,
+		[](const _Value &v, const void *var) {return valueLess(v.var, var);});
+	if(iter == m_values.end() || iter->var != var) {
+		return NULL;
+	}
+	return &(*iter);
+}
+
+} // namespace
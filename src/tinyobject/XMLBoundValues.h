@@ -0,0 +1,108 @@
+/*==============================================================================
+
+	XMLBoundValues.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include "XML.h"
+
+namespace tinyxml2 {
+
+class XMLObject;
+
+/// \class XMLBoundValues
+/// \brief an immutable set of decoded values for subscribed variables
+///
+/// filled by XMLObject::loadXML when buffered loading is enabled and then
+/// published as a whole, values are looked up by the address of the variable
+/// they were subscribed with
+///
+/// XML_TYPE_STRING_VIEW values are copied into the set, so views taken from it
+/// are valid as long as the set is held
+///
+class XMLBoundValues {
+
+	public:
+
+		XMLBoundValues() : m_sequence(0) {}
+
+		/// get the value for a subscribed variable,
+		/// returns true on success or false if the variable is not bound
+		/// or was subscribed with a different type
+		bool get(const void *var, XMLType type, void *value) const;
+
+		/// get the value for a subscribed variable by type,
+		/// returns defaultVal if the variable is not bound
+		template<class T> T get(const T *var, T defaultVal=T()) const {
+			T value;
+			if(get(var, XMLTypeOf<T>::type, &value)) {
+				return value;
+			}
+			return defaultVal;
+		}
+
+		/// copy all values into their subscribed variables,
+		/// only call this from the thread which owns the variables
+		void apply() const;
+
+		/// number of bound values
+		inline unsigned int size() const {return m_values.size();}
+
+		/// publish sequence number, increases with every buffered load
+		inline unsigned long getSequence() const {return m_sequence;}
+
+	private:
+
+		friend class XMLObject;
+
+		/// decoded value
+		struct _Value {
+			const void *var; ///< subscribed variable, lookup key
+			XMLType type; ///< value type
+			union {
+				bool b;
+				int i;
+				unsigned int ui;
+				float f;
+				double d;
+			} num; ///< numeric value
+			std::string s; ///< string value
+			std::string_view view; ///< string view value, points into s once finished
+			std::vector<int> ints; ///< int array value
+			std::vector<float> floats; ///< float array value
+			std::vector<double> doubles; ///< double array value
+		};
+
+		/// add a value for a variable,
+		/// returns a pointer to the value storage to decode into
+		void* add(const void *var, XMLType type);
+
+		/// sort values by variable address & drop duplicates, keeps the last one added
+		void finish(unsigned long sequence);
+
+		/// find a value by variable address, returns NULL if not found
+		const _Value* find(const void *var) const;
+
+		std::vector<_Value> m_values; ///< values sorted by variable address
+		unsigned long m_sequence; ///< publish sequence number
+};
+
+} // namespace
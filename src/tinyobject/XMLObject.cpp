@@ -24,19 +24,95 @@
 
 #include <map>
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include "Alloc.h"
 #include "Log.h"
+#include "Profile.h"
 #include "XML.h"
 
 //#define DEBUG_XML_OBJECT
 
 namespace tinyxml2 {
 
-XMLObject::XMLObject(std::string elementName) :
-	m_docLoaded(false), m_xmlDoc(NULL), m_element(NULL),
-	m_elementName(elementName) {}
+XMLObject::XMLObject(std::string elementName, std::pmr::memory_resource *resource) :
+	m_docLoaded(false), m_xmlDoc(NULL), m_docResource(NULL), m_element(NULL),
+	m_lazyLoad(false), m_loadPending(false), m_snapshotEnabled(false),
+	m_bufferedLoad(false), m_valuesSequence(0), m_stringArena(NULL),
+	m_elementName(elementName), m_resource(resource),
+	m_elements(resource ? resource : XML::getMemoryResource()), m_bindings(NULL),
+	m_planEnabled(false), m_structureVersion(0), m_parent(NULL),
+	m_valueCacheEnabled(false), m_valueCache(m_elements.get_allocator().resource()) {}
+
+XMLObject::XMLObject(XMLObject &&from) noexcept :
+	m_docLoaded(false), m_xmlDoc(NULL), m_docResource(NULL), m_element(NULL),
+	m_lazyLoad(false), m_loadPending(false), m_snapshotEnabled(false),
+	m_bufferedLoad(false), m_valuesSequence(0), m_stringArena(NULL),
+	m_resource(from.m_resource), m_elements(from.m_elements.get_allocator()),
+	m_bindings(NULL), m_planEnabled(false), m_structureVersion(0), m_parent(NULL),
+	m_valueCacheEnabled(false), m_valueCache(m_elements.get_allocator().resource()) {
+	moveXML(from);
+}
+
+XMLObject& XMLObject::operator=(XMLObject &&from) {
+	if(&from == this) {
+		return *this;
+	}
+
+	// release everything, the links to the parent & children go with the values
+	unsubscribeAllXMLElements();
+	unsubscribeAllXMLLists();
+	unsubscribeAllXMLFactories();
+	closeXMLFile();
+	for(unsigned int i = 0; i < m_objects.size(); ++i) {
+		if(m_objects[i] != NULL && m_objects[i]->m_parent == this) {
+			m_objects[i]->m_parent = NULL;
+		}
+	}
+	m_objects.clear();
+	if(m_parent != NULL) {
+		m_parent->removeXMLObject(this);
+	}
+
+	// nodes from another resource can't be taken over, copy them instead,
+	// moveXML() re-points the copies
+	if(m_elements.get_allocator() != from.m_elements.get_allocator()) {
+		for(unsigned int i = 0; i < from.m_elements.size(); ++i) {
+			_Element *f = from.m_elements[i];
+			_Element *e = newXMLNode<_Element>();
+			e->path = f->path;
+			e->type = f->type;
+			e->var = f->var;
+			e->readOnly = f->readOnly;
+			for(unsigned int j = 0; j < f->attributes.size(); ++j) {
+				_Attribute *attr = newXMLNode<_Attribute>();
+				*attr = *f->attributes[j];
+				e->attributes.push_back(attr);
+			}
+			indexXMLAttributes(e);
+			m_elements.push_back(e);
+		}
+		from.unsubscribeAllXMLElements();
+	}
+
+	moveXML(from);
+	return *this;
+}
 
 XMLObject::~XMLObject() {
+	if(m_parent != NULL) {
+		m_parent->removeXMLObject(this);
+	}
+	for(unsigned int i = 0; i < m_objects.size(); ++i) {
+		if(m_objects[i] != NULL && m_objects[i]->m_parent == this) {
+			m_objects[i]->m_parent = NULL;
+		}
+	}
 	unsubscribeAllXMLElements();
+	unsubscribeAllXMLLists();
+	unsubscribeAllXMLFactories();
 	closeXMLFile();
 }
 
@@ -44,7 +120,7 @@ void XMLObject::initXML() {
 	if(m_docLoaded) {
 		closeXMLFile();
 	}
-	m_xmlDoc = new XMLDocument;
+	newXMLDocument();
 
 	// add the default declaration: 1.0 UTF-8
 	m_xmlDoc->InsertEndChild(m_xmlDoc->NewDeclaration());
@@ -52,7 +128,7 @@ void XMLObject::initXML() {
 	// add root element
 	XMLElement *root = m_xmlDoc->NewElement(getXMLName().c_str());
 	m_xmlDoc->InsertEndChild(root);
-	m_element = root;
+	resetXMLElement(root);
 
 	m_docLoaded = true;
 }
@@ -60,23 +136,56 @@ void XMLObject::initXML() {
 // LOAD
 
 bool XMLObject::loadXML(XMLElement *e) {
+	XML_ALLOC_SCOPE(XML_ALLOC_LOAD_XML);
+	if(!m_bufferedLoad) {
+		return loadXML(e, NULL);
+	}
+
+	// decode into a new set & publish it once everything is loaded
+	std::shared_ptr<XMLBoundValues> values(new XMLBoundValues);
+	bool ret = loadXML(e, values.get());
+	if(e != NULL && m_element == e) {
+		values->finish(++m_valuesSequence);
+		m_values.store(values);
+	}
+	return ret;
+}
+
+bool XMLObject::loadXML(XMLElement *e, XMLBoundValues *values) {
+	XML_ALLOC_SCOPE(XML_ALLOC_LOAD_XML);
+	XMLMemoryScope memoryScope(m_resource);
 	if(e == NULL) {
 		return false;
 	}
 
 	// check if the element is correct
-	if(!m_elementName.empty() && (std::string)e->Name() != m_elementName) {
+	if(!m_elementName.empty() && m_elementName != e->Name()) {
 		LOG_WARN << "XML \"" << m_elementName << "\": wrong xml element name \""
 		         << e->Name() << "\" for object with element name \""
 		         << m_elementName << "\"" << std::endl;
 		return false;
 	}
-	m_element = e;
+	resetXMLElement(e);
+	m_loadPending = false;
+	XML_PROFILE_CALL(m_profile.load);
+	XML_PROFILE_MARK(mark);
+	XML_TRACE_BEGIN(span, "loadXML", m_elementName);
 
 	#ifdef DEBUG_XML_OBJECT
 		LOG_DEBUG << "loading xml " << m_elementName << std::endl;
 	#endif
 
+	// run the compiled plan for the values & attached objects instead
+	if(m_planEnabled && values == NULL) {
+		runXMLLoadPlan(e);
+		XML_PROFILE_RESET(mark);
+		XML_TRACE_BEGIN(callbackSpan, "readXML", m_elementName);
+		bool ret = readXML(e);
+		XML_TRACE_END(callbackSpan);
+		XML_PROFILE_ADD(mark, m_profile.load, callbackTime);
+		return ret;
+	}
+
 	XMLElement *child;
 
 	// load attached elements
@@ -88,7 +197,7 @@ bool XMLObject::loadXML(XMLElement *e) {
 		#endif
 
 		// check if this element is the same as the root
-		if((std::string)e->Name() == elem->path) {
+		if(elem->path == e->Name()) {
 			child = e;
 		}
 		else { // try to find a child with the same element name
@@ -99,22 +208,34 @@ bool XMLObject::loadXML(XMLElement *e) {
 
 			// load the elements text
 			if(elem->var != NULL) {
-				XML::getText(child, elem->type, elem->var);
+				XML::getText(child, elem->type, values ? values->add(elem->var, elem->type) : elem->var);
+				if(elem->type == XML_TYPE_STRING_VIEW && values == NULL) {
+					internView(elem->var);
+				}
 			}
 
 			// load the attached attributes
-			for(unsigned int j = 0; j < elem->attributes.size(); ++j) {
-				_Attribute *attr = elem->attributes.at(j);
-				#ifdef DEBUG_XML_OBJECT
-					LOG_DEBUG << "    attr: " << attr->name << std::endl;
-				#endif
-				XML::getAttr(child, attr->name, attr->type, attr->var);
+			if(!elem->attributes.empty()) {
+				loadXMLAttributes(child, elem, values);
 			}
 		}
 	}
 
+	if(m_bindings != NULL) {
+		loadXMLBindings(e, values);
+	}
+
+	// load subscribed lists in place, not part of the buffered values
+	if(values == NULL) {
+		loadXMLLists(e);
+	}
+	else if(!m_lists.empty() || !m_factories.empty()) {
+		LOG_WARN_LIMITED << "XML \"" << m_elementName << "\": lists are not loaded when buffered" << std::endl;
+	}
+	XML_PROFILE_ADD(mark, m_profile.load, subscriptionTime);
+
 	// keep track of how many elements with the same name
-	std::map<std::string, int> elementMap;
+	std::pmr::map<std::string_view, int> elementMap(getXMLMemoryResource());
 
 	// load attached objects
 	std::vector<XMLObject *>::iterator objectIter;
@@ -130,17 +251,17 @@ bool XMLObject::loadXML(XMLElement *e) {
 		
 			// check the parent element
 			if((*objectIter)->getXMLName() == "" ||
-				(*objectIter)->getXMLName() == (std::string)e->Name()) {
+				(*objectIter)->getXMLName() == e->Name()) {
 				// same element as parent
 				elementToLoad = e;
 			}
 			else { // find element in list using xml name
 
 				// try to find element name in map
-				std::map<std::string, int>::iterator iter = elementMap.find((*objectIter)->getXMLName());
+				std::pmr::map<std::string_view, int>::iterator iter = elementMap.find((*objectIter)->getXMLName());
 				if(iter == elementMap.end()) {
 					// not found, so add element name to map
-					elementMap.insert(make_pair((*objectIter)->getXMLName(), 0));
+					elementMap.insert(make_pair(std::string_view((*objectIter)->getXMLName()), 0));
 					iter = elementMap.find((*objectIter)->getXMLName());
 				}
 				else {
@@ -157,7 +278,14 @@ bool XMLObject::loadXML(XMLElement *e) {
 					LOG_DEBUG << "object: " << (*objectIter)->getXMLName()
 					          << " " << e->Name() << std::endl;
 				#endif
-				(*objectIter)->loadXML(elementToLoad);  // found element
+				if((*objectIter)->m_lazyLoad) {
+					// record element only, loaded on first ensureXMLLoaded()
+					(*objectIter)->resetXMLElement(elementToLoad);
+					(*objectIter)->m_loadPending = true;
+				}
+				else {
+					(*objectIter)->loadXML(elementToLoad, values);  // found element
+				}
 			}
 			else {
 				LOG_WARN << "XMLObject: element not found for \""
@@ -167,12 +295,26 @@ bool XMLObject::loadXML(XMLElement *e) {
 			++objectIter; // increment iter
 		}
 	}
+	XML_PROFILE_SKIP(mark, m_profile.load, objectTime);
 
 	// process user callback
-	return readXML(e);
+	XML_TRACE_BEGIN(callbackSpan, "readXML", m_elementName);
+	bool ret = readXML(e);
+	XML_TRACE_END(callbackSpan);
+	XML_PROFILE_ADD(mark, m_profile.load, callbackTime);
+	return ret;
+}
+
+bool XMLObject::ensureXMLLoaded() {
+	if(!m_loadPending) {
+		return m_element != NULL;
+	}
+	return loadXML(m_element);
 }
 
 bool XMLObject::loadXMLFile(std::string filename) {
+	XML_ALLOC_SCOPE(XML_ALLOC_LOAD_XML_FILE);
+	XMLMemoryScope memoryScope(m_resource);
 	// close if loaded
 	if(m_docLoaded) {
 		closeXMLFile();
@@ -184,8 +326,10 @@ bool XMLObject::loadXMLFile(std::string filename) {
 	}
 
 	// try to load the file
-	m_xmlDoc = new XMLDocument;
-	int ret = m_xmlDoc->LoadFile(filename.c_str());
+	XML_TRACE_BEGIN(span, "loadXMLFile", filename);
+	XML_PROFILE_MARK(mark);
+	newXMLDocument();
+	int ret = XML_LOAD_FILE(m_xmlDoc, filename.c_str());
 	if(ret != XML_SUCCESS) {
 		LOG_ERROR << "XML \"" << m_elementName << "\": could not load \"" << filename
 		          << "\": " << XML::getErrorString(m_xmlDoc) << std::endl;
@@ -197,7 +341,7 @@ bool XMLObject::loadXMLFile(std::string filename) {
 	XMLElement *root = m_xmlDoc->RootElement();
 
 	// check if the root is correct
-	if(!root || (std::string)root->Name() != m_elementName) {
+	if(!root || m_elementName != root->Name()) {
 		LOG_ERROR << "XML \"" << m_elementName << "\": xml file \"" << filename
 		          << "\" does not have \"" << m_elementName << "\" as the root element"
 		          << std::endl;
@@ -207,6 +351,12 @@ bool XMLObject::loadXMLFile(std::string filename) {
 
 	m_filename = filename;
 	m_docLoaded = true;
+	XML_PROFILE_ADD(mark, m_profile.load, fileTime);
+
+	// publish before objects are loaded as callbacks may change the document
+	if(m_snapshotEnabled) {
+		publishXMLSnapshot();
+	}
 
 	// load everything
 	return loadXML(root);
@@ -215,22 +365,43 @@ bool XMLObject::loadXMLFile(std::string filename) {
 // SAVE
 
 bool XMLObject::saveXML(XMLElement *e) {
+	XML_ALLOC_SCOPE(XML_ALLOC_SAVE_XML);
+	XMLMemoryScope memoryScope(m_resource);
 	if(e == NULL) {
 		return false;
 	}
 
 	// check if the element is correct
-	if(!m_elementName.empty() && (std::string)e->Name() != m_elementName) {
+	if(!m_elementName.empty() && m_elementName != e->Name()) {
 		LOG_WARN << "XML \"" << m_elementName << "\": xml element value is not \""
 		         << m_elementName << "\"" << std::endl;
 		return false;
 	}
-	m_element = e;
+
+	// a pending lazy load has to happen first or unloaded values are written
+	if(m_loadPending) {
+		ensureXMLLoaded();
+	}
+	resetXMLElement(e);
+	XML_PROFILE_CALL(m_profile.save);
+	XML_PROFILE_MARK(mark);
+	XML_TRACE_BEGIN(span, "saveXML", m_elementName);
 
 	#ifdef DEBUG_XML_OBJECT
 		LOG_DEBUG << "saving xml " << m_elementName << std::endl;
 	#endif
 
+	// run the compiled plan for the values & attached objects instead
+	if(m_planEnabled) {
+		runXMLSavePlan(e);
+		XML_PROFILE_RESET(mark);
+		XML_TRACE_BEGIN(callbackSpan, "writeXML", m_elementName);
+		bool ret = writeXML(e) || true;
+		XML_TRACE_END(callbackSpan);
+		XML_PROFILE_ADD(mark, m_profile.save, callbackTime);
+		return ret;
+	}
+
 	XMLElement *child;
 
 	// save attached elements
@@ -242,7 +413,7 @@ bool XMLObject::saveXML(XMLElement *e) {
 		#endif
 
 		// check if this element is the same as the root
-		if((std::string)e->Name() == elem->path) {
+		if(elem->path == e->Name()) {
 			child = e;
 		}
 		else {
@@ -253,6 +424,9 @@ bool XMLObject::saveXML(XMLElement *e) {
 		// set the element's text if any
 		if(elem->var != NULL && !elem->readOnly) {
 			XML::setText(child, elem->type, elem->var);
+			if(elem->type == XML_TYPE_STRING_VIEW) {
+				internView(elem->var);
+			}
 		}
 
 		// save the element's attached attributes
@@ -263,12 +437,20 @@ bool XMLObject::saveXML(XMLElement *e) {
 			#endif
 			if(!attr->readOnly) {
 				XML::setAttr(child, attr->name, attr->type, attr->var);
+				if(attr->type == XML_TYPE_STRING_VIEW) {
+					internView(attr->var);
+				}
 			}
 		}
 	}
+	if(m_bindings != NULL) {
+		saveXMLBindings(e);
+	}
+	saveXMLLists(e);
+	XML_PROFILE_ADD(mark, m_profile.save, subscriptionTime);
 
 	// keep track of how many elements with the same name
-	std::map<std::string, int> elementMap;
+	std::pmr::map<std::string_view, int> elementMap(getXMLMemoryResource());
 
 	// save all attached objects
 	bool ret = true;
@@ -286,10 +468,10 @@ bool XMLObject::saveXML(XMLElement *e) {
 			if(!(*objectIter)->getXMLName().empty()) {
 
 				// try to find element name in map
-				std::map<std::string, int>::iterator iter = elementMap.find((*objectIter)->getXMLName());
+				std::pmr::map<std::string_view, int>::iterator iter = elementMap.find((*objectIter)->getXMLName());
 				if(iter == elementMap.end()) {
 					// not found, so add element name to map
-					elementMap.insert(make_pair((*objectIter)->getXMLName(), 0));
+					elementMap.insert(make_pair(std::string_view((*objectIter)->getXMLName()), 0));
 					iter = elementMap.find((*objectIter)->getXMLName());
 				}
 				else {
@@ -313,13 +495,21 @@ bool XMLObject::saveXML(XMLElement *e) {
 			++objectIter; // increment iter
 		}
 	}
+	XML_PROFILE_SKIP(mark, m_profile.save, objectTime);
 
 	// process user callback
-	return writeXML(e) || ret;
+	XML_TRACE_BEGIN(callbackSpan, "writeXML", m_elementName);
+	ret = writeXML(e) || ret;
+	XML_TRACE_END(callbackSpan);
+	XML_PROFILE_ADD(mark, m_profile.save, callbackTime);
+	return ret;
 }
 
 bool XMLObject::saveXMLFile(std::string filename) {
+	XML_ALLOC_SCOPE(XML_ALLOC_SAVE_XML_FILE);
+	XMLMemoryScope memoryScope(m_resource);
 	XMLElement *root;
+	XML_TRACE_BEGIN(span, "saveXMLFile", filename.empty() ? m_filename : filename);
 
 	// setup new doc if not loaded
 	if(!m_docLoaded) {
@@ -336,34 +526,104 @@ bool XMLObject::saveXMLFile(std::string filename) {
 	bool ret = saveXML(root);
 
 	// try saving
-	if(m_xmlDoc->SaveFile(filename.c_str()) != XML_SUCCESS) {
+	XML_PROFILE_MARK(mark);
+	if(XML_SAVE_FILE(m_xmlDoc, filename.c_str()) != XML_SUCCESS) {
 		LOG_ERROR << "XML \"" << m_elementName << "\": could not save to \""
 		          << filename << "\"" << std::endl;
 		return false;
 	}
+	XML_PROFILE_ADD(mark, m_profile.save, fileTime);
 	return ret;
 }
 
 void XMLObject::closeXMLFile() {
 	if(m_docLoaded) {
-		delete m_xmlDoc;
-		m_xmlDoc = NULL;
-		m_element = NULL;
+		cancelXMLLoad();
+		deleteXMLDocument();
+		resetXMLElement(NULL);
 	}
 	m_docLoaded = false;
 }
 
+// PROFILING
+
+bool XMLObject::isXMLProfileEnabled() {
+	#ifdef TINYOBJECT_PROFILE
+		return true;
+	#else
+		return false;
+	#endif
+}
+
+void XMLObject::resetXMLProfile() {
+	m_profile.clear();
+	for(unsigned int i = 0; i < m_objects.size(); ++i) {
+		if(m_objects[i] != NULL) {
+			m_objects[i]->resetXMLProfile();
+		}
+	}
+}
+
+std::string XMLObject::getXMLProfileTable() {
+	if(!isXMLProfileEnabled()) {
+		return "";
+	}
+	std::ostringstream stream;
+	stream << std::left << std::setw(24) << "object" << std::right
+	       << std::setw(8) << "loads" << std::setw(10) << "file"
+	       << std::setw(10) << "subs" << std::setw(10) << "objects"
+	       << std::setw(10) << "read" << std::setw(8) << "paths"
+	       << std::setw(10) << "siblings"
+	       << std::setw(8) << "saves" << std::setw(10) << "file"
+	       << std::setw(10) << "subs" << std::setw(10) << "objects"
+	       << std::setw(10) << "write" << std::setw(8) << "paths"
+	       << std::setw(10) << "siblings" << std::setw(10) << "created"
+	       << std::endl;
+	addXMLProfileRows(stream, 0);
+	return stream.str();
+}
+
+// SNAPSHOTS
+
+void XMLObject::publishXMLSnapshot() {
+	if(!m_docLoaded) {
+		return;
+	}
+	m_snapshot.store(XMLSnapshot::create(m_xmlDoc));
+}
+
+std::shared_ptr<const XMLSnapshot> XMLObject::getXMLSnapshot() const {
+	return m_snapshot.load();
+}
+
+// BUFFERED LOADING
+
+std::shared_ptr<const XMLBoundValues> XMLObject::getXMLBoundValues() const {
+	return m_values.load();
+}
+
+void XMLObject::applyXMLBoundValues() {
+	std::shared_ptr<const XMLBoundValues> values = getXMLBoundValues();
+	if(values) {
+		values->apply();
+		m_appliedValues = values; // applied string views point into it
+	}
+}
+
 // OBJECTS
 
 void XMLObject::addXMLObject(XMLObject *object) {
+	changedXMLStructure();
 	if(object == NULL) {
 		LOG_WARN << "XML: Cannot add NULL object" << std::endl;
 		return;
 	}
 	m_objects.push_back(object);
+	object->m_parent = this;
 }
 
 void XMLObject::removeXMLObject(XMLObject *object) {
+	changedXMLStructure();
 	if(object == NULL) {
 		LOG_WARN << "XML: Cannot remove NULL object" << std::endl;
 		return;
@@ -373,11 +633,15 @@ void XMLObject::removeXMLObject(XMLObject *object) {
 	if(iter != m_objects.end()) {
 		m_objects.erase(iter);
 	}
+	if(object->m_parent == this) {
+		object->m_parent = NULL;
+	}
 }
 
 // ELEMENTS
 
-bool XMLObject::subscribeXMLElement(std::string path, XMLType type, void *var, bool readOnly) {
+bool XMLObject::subscribeXMLElement(std::string_view path, XMLType type, void *var, bool readOnly) {
+	changedXMLStructure();
 	if(path == "") {
 		path = m_elementName;
 	}
@@ -392,7 +656,7 @@ bool XMLObject::subscribeXMLElement(std::string path, XMLType type, void *var, b
 		element->readOnly = readOnly;
 	}
 	else { // add
-		element = new _Element;
+		element = newXMLNode<_Element>();
 		element->path = path;
 		element->type = type;
 		element->var = var;
@@ -402,11 +666,12 @@ bool XMLObject::subscribeXMLElement(std::string path, XMLType type, void *var, b
 	return true;
 }
 
-bool XMLObject::unsubscribeXMLElement(std::string path) {
-	std::vector<_Element*>::iterator iter;
+bool XMLObject::unsubscribeXMLElement(std::string_view path) {
+	changedXMLStructure();
+	std::pmr::vector<_Element*>::iterator iter;
 	for(iter = m_elements.begin(); iter != m_elements.end(); ++iter) {
 		if((*iter)->path == path) {
-			delete (*iter);
+			deleteXMLNode(*iter);
 			m_elements.erase(iter);
 			return true;
 		}
@@ -417,21 +682,24 @@ bool XMLObject::unsubscribeXMLElement(std::string path) {
 }
 
 void XMLObject::unsubscribeAllXMLElements() {
+	changedXMLStructure();
 	for(unsigned int i = 0; i < m_elements.size(); ++i) {
 		_Element *e = m_elements.at(i);
 		for(unsigned int j = 0; j < e->attributes.size(); ++j) {
 			_Attribute *attr = e->attributes.at(j);
-			delete attr;
+			deleteXMLNode(attr);
 		}
 		e->attributes.clear();
-		delete e;
+		e->attributeIndex.clear();
+		deleteXMLNode(e);
 	}
 	m_elements.clear();
 }
 
 // ATTRIBUTES
 
-bool XMLObject::subscribeXMLAttribute(std::string path, std::string name, XMLType type, void *var, bool readOnly) {
+bool XMLObject::subscribeXMLAttribute(std::string_view path, std::string_view name, XMLType type, void *var, bool readOnly) {
+	changedXMLStructure();
 	if(name == "") {
 		LOG_WARN << "XML \"" << m_elementName << "\": cannot add attribute to element \""
 		          << path << "\", name is empty"
@@ -474,27 +742,30 @@ bool XMLObject::subscribeXMLAttribute(std::string path, std::string name, XMLTyp
 		attribute->readOnly = readOnly;
 	}
 	else { // add
-		attribute = new _Attribute;
+		attribute = newXMLNode<_Attribute>();
 		attribute->name = name;
 		attribute->type = type;
 		attribute->var = var;
 		attribute->readOnly = readOnly;
 		e->attributes.push_back(attribute);
+		e->attributeIndex.add(attribute->name);
 	}
 
 	return true;
 }
 
-bool XMLObject::unsubscribeXMLAttribute(std::string path, std::string name) {
+bool XMLObject::unsubscribeXMLAttribute(std::string_view path, std::string_view name) {
+	changedXMLStructure();
 	_Element *e = findElement(path);
 	if(e == NULL) {
 		return false;
 	}
-	std::vector<_Attribute*>::iterator iter;
+	std::pmr::vector<_Attribute*>::iterator iter;
 	for(iter = e->attributes.begin(); iter != e->attributes.end(); ++iter) {
 		if((*iter)->name == name) {
-			delete (*iter);
+			deleteXMLNode(*iter);
 			e->attributes.erase(iter);
+			indexXMLAttributes(e);
 			return true;
 		}
 	}
@@ -504,16 +775,18 @@ bool XMLObject::unsubscribeXMLAttribute(std::string path, std::string name) {
 }
 
 void XMLObject::unsubscribeAllXMLAttributes() {
-	std::vector<_Element*>::iterator iter;
+	changedXMLStructure();
+	std::pmr::vector<_Element*>::iterator iter;
 	for(iter = m_elements.begin(); iter != m_elements.end();) {
 		_Element *e = (*iter);
 		for(unsigned int j = 0; j < e->attributes.size(); ++j) {
 			_Attribute *attr = e->attributes.at(j);
-			delete attr;
+			deleteXMLNode(attr);
 		}
 		e->attributes.clear();
+		e->attributeIndex.clear();
 		if(e->var == NULL) { // remove elements which were not subscribed to
-			delete e;
+			deleteXMLNode(e);
 			iter = m_elements.erase(iter);
 		}
 		else {
@@ -523,124 +796,310 @@ void XMLObject::unsubscribeAllXMLAttributes() {
 	m_elements.clear();
 }
 
+// LISTS
+
+bool XMLObject::unsubscribeXMLList(std::string_view path, std::string_view name) {
+	changedXMLStructure();
+	std::vector<_List*>::iterator iter;
+	for(iter = m_lists.begin(); iter != m_lists.end(); ++iter) {
+		if((*iter)->path == path && (*iter)->name == name) {
+			delete (*iter);
+			m_lists.erase(iter);
+			return true;
+		}
+	}
+	LOG_WARN << "XML \"" << m_elementName << "\": cannot remove list \""
+	         << name << "\" at element \"" << path << "\", not found" << std::endl;
+	return false;
+}
+
+void XMLObject::unsubscribeAllXMLLists() {
+	changedXMLStructure();
+	for(unsigned int i = 0; i < m_lists.size(); ++i) {
+		delete m_lists[i];
+	}
+	m_lists.clear();
+}
+
+// FACTORIES
+
+bool XMLObject::subscribeXMLFactory(std::string_view path, XMLObjectFactory *factory,
+                                    std::vector<XMLObject*> *objects, bool readOnly) {
+	changedXMLStructure();
+	if(factory == NULL || objects == NULL) {
+		LOG_WARN << "XML \"" << m_elementName << "\": factory at element \"" << path
+		         << "\" factory and/or vector pointer is NULL" << std::endl;
+		return false;
+	}
+
+	// replace an existing subscription
+	for(unsigned int i = 0; i < m_factories.size(); ++i) {
+		if(m_factories[i]->path == path) {
+			LOG_WARN << "XML \"" << m_elementName << "\": factory at element \"" << path
+			         << "\" already subscribed, resubscribing with new pointers" << std::endl;
+			m_factories[i]->factory = factory;
+			m_factories[i]->objects = objects;
+			m_factories[i]->readOnly = readOnly;
+			return true;
+		}
+	}
+	_Factory *f = new _Factory;
+	f->path = path;
+	f->factory = factory;
+	f->objects = objects;
+	f->readOnly = readOnly;
+	m_factories.push_back(f);
+	return true;
+}
+
+bool XMLObject::unsubscribeXMLFactory(std::string_view path) {
+	changedXMLStructure();
+	std::vector<_Factory*>::iterator iter;
+	for(iter = m_factories.begin(); iter != m_factories.end(); ++iter) {
+		if((*iter)->path == path) {
+			delete (*iter);
+			m_factories.erase(iter);
+			return true;
+		}
+	}
+	LOG_WARN << "XML \"" << m_elementName << "\": cannot remove factory at element \""
+	         << path << "\", not found" << std::endl;
+	return false;
+}
+
+void XMLObject::unsubscribeAllXMLFactories() {
+	changedXMLStructure();
+	for(unsigned int i = 0; i < m_factories.size(); ++i) {
+		delete m_factories[i];
+	}
+	m_factories.clear();
+}
+
+// BINDINGS
+
+bool XMLObject::setXMLBindings(const XMLBindings *bindings) {
+	if(bindings != NULL && !bindings->isBindable(this)) {
+		LOG_ERROR << "XML \"" << m_elementName << "\": cannot set bindings, "
+		          << "the table binds members of a different class" << std::endl;
+		return false;
+	}
+	m_bindings = bindings;
+	changedXMLStructure();
+	return true;
+}
+
 // DATA ACCESS
 
-bool XMLObject::getXMLTextBool(std::string path, bool defaultVal) {
+bool XMLObject::getXMLTextBool(std::string_view path, bool defaultVal) {
+	if(m_valueCacheEnabled) {
+		return getXMLCachedValue<bool>(path, "", XML_TYPE_BOOL).valueOr(defaultVal);
+	}
 	return XML::getTextBool(XML::getChild(m_element, path), defaultVal);
 }
 
-int XMLObject::getXMLTextInt(std::string path, int defaultVal) {
+int XMLObject::getXMLTextInt(std::string_view path, int defaultVal) {
+	if(m_valueCacheEnabled) {
+		return getXMLCachedValue<int>(path, "", XML_TYPE_INT).valueOr(defaultVal);
+	}
 	return XML::getTextInt(XML::getChild(m_element, path), defaultVal);
 }
 
-unsigned int XMLObject::getXMLTextUInt(std::string path, unsigned int defaultVal) {
+unsigned int XMLObject::getXMLTextUInt(std::string_view path, unsigned int defaultVal) {
+	if(m_valueCacheEnabled) {
+		return getXMLCachedValue<unsigned int>(path, "", XML_TYPE_UINT).valueOr(defaultVal);
+	}
 	return XML::getTextUInt(XML::getChild(m_element, path), defaultVal);
 }
 
-float XMLObject::getXMLTextFloat(std::string path, float defaultVal) {
+float XMLObject::getXMLTextFloat(std::string_view path, float defaultVal) {
+	if(m_valueCacheEnabled) {
+		return getXMLCachedValue<float>(path, "", XML_TYPE_FLOAT).valueOr(defaultVal);
+	}
 	return XML::getTextFloat(XML::getChild(m_element, path), defaultVal);
 }
 
-double XMLObject::getXMLTextDouble(std::string path, double defaultVal) {
+double XMLObject::getXMLTextDouble(std::string_view path, double defaultVal) {
+	if(m_valueCacheEnabled) {
+		return getXMLCachedValue<double>(path, "", XML_TYPE_DOUBLE).valueOr(defaultVal);
+	}
 	return XML::getTextDouble(XML::getChild(m_element, path), defaultVal);
 }
 
-std::string XMLObject::getXMLTextString(std::string path, std::string defaultVal) {
+std::string XMLObject::getXMLTextString(std::string_view path, std::string_view defaultVal) {
+	if(m_valueCacheEnabled) {
+		XMLResult<const char*> result = getXMLCachedValue<const char*>(path, "", XML_TYPE_STRING_VIEW);
+		return std::string(result.ok() ? std::string_view(result.value) : defaultVal);
+	}
 	return XML::getTextString(XML::getChild(m_element, path), defaultVal);
 }
 
-bool XMLObject::getXMLAttrBool(std::string path, std::string name, bool defaultVal){
+std::string_view XMLObject::getXMLTextView(std::string_view path, std::string_view defaultVal) {
+	if(m_valueCacheEnabled) {
+		XMLResult<const char*> result = getXMLCachedValue<const char*>(path, "", XML_TYPE_STRING_VIEW);
+		return std::string_view(result.ok() ? std::string_view(result.value) : defaultVal);
+	}
+	return XML::getTextView(XML::getChild(m_element, path), defaultVal);
+}
+
+bool XMLObject::getXMLAttrBool(std::string_view path, std::string_view name, bool defaultVal) {
+	if(m_valueCacheEnabled) {
+		return getXMLCachedValue<bool>(path, name, XML_TYPE_BOOL).valueOr(defaultVal);
+	}
 	return XML::getAttrBool(XML::getChild(m_element, path), name, defaultVal);
 }
 
-int XMLObject::getXMLAttrInt(std::string path, std::string name, int defaultVal) {
+int XMLObject::getXMLAttrInt(std::string_view path, std::string_view name, int defaultVal) {
+	if(m_valueCacheEnabled) {
+		return getXMLCachedValue<int>(path, name, XML_TYPE_INT).valueOr(defaultVal);
+	}
 	return XML::getAttrInt(XML::getChild(m_element, path), name, defaultVal);
 }
 
-unsigned int XMLObject::getXMLAttrUInt(std::string path, std::string name, unsigned int defaultVal) {
+unsigned int XMLObject::getXMLAttrUInt(std::string_view path, std::string_view name, unsigned int defaultVal) {
+	if(m_valueCacheEnabled) {
+		return getXMLCachedValue<unsigned int>(path, name, XML_TYPE_UINT).valueOr(defaultVal);
+	}
 	return XML::getAttrUInt(XML::getChild(m_element, path), name, defaultVal);
 }
 
-float XMLObject::getXMLAttrFloat(std::string path, std::string name, float defaultVal) {
+float XMLObject::getXMLAttrFloat(std::string_view path, std::string_view name, float defaultVal) {
+	if(m_valueCacheEnabled) {
+		return getXMLCachedValue<float>(path, name, XML_TYPE_FLOAT).valueOr(defaultVal);
+	}
 	return XML::getAttrFloat(XML::getChild(m_element, path), name, defaultVal);
 }
 
-double XMLObject::getXMLAttrDouble(std::string path, std::string name, double defaultVal) {
+double XMLObject::getXMLAttrDouble(std::string_view path, std::string_view name, double defaultVal) {
+	if(m_valueCacheEnabled) {
+		return getXMLCachedValue<double>(path, name, XML_TYPE_DOUBLE).valueOr(defaultVal);
+	}
 	return XML::getAttrDouble(XML::getChild(m_element, path), name, defaultVal);
 }
 
-std::string XMLObject::getXMLAttrString(std::string path, std::string name, std::string defaultVal) {
+std::string XMLObject::getXMLAttrString(std::string_view path, std::string_view name, std::string_view defaultVal) {
+	if(m_valueCacheEnabled) {
+		XMLResult<const char*> result = getXMLCachedValue<const char*>(path, name, XML_TYPE_STRING_VIEW);
+		return std::string(result.ok() ? std::string_view(result.value) : defaultVal);
+	}
 	return XML::getAttrString(XML::getChild(m_element, path), name, defaultVal);
 }
 
-XMLElement* XMLObject::getXMLChild(std::string path, int index) {
+std::string_view XMLObject::getXMLAttrView(std::string_view path, std::string_view name, std::string_view defaultVal) {
+	if(m_valueCacheEnabled) {
+		XMLResult<const char*> result = getXMLCachedValue<const char*>(path, name, XML_TYPE_STRING_VIEW);
+		return std::string_view(result.ok() ? std::string_view(result.value) : defaultVal);
+	}
+	return XML::getAttrView(XML::getChild(m_element, path), name, defaultVal);
+}
+
+XMLElement* XMLObject::getXMLChild(std::string_view path, int index) {
 	return XML::getChild(m_element, path, index);
 }
 
-unsigned int XMLObject::getNumXMLChildren(std::string path, std::string name) {
+unsigned int XMLObject::getNumXMLChildren(std::string_view path, std::string_view name) {
 	return XML::getNumChildren(XML::getChild(m_element, path), name);
 }
 
-void XMLObject::setXMLTextBool(std::string path, bool b) {
-	XML::setTextBool(XML::obtainChild(m_element, path), b);
+void XMLObject::setXMLTextBool(std::string_view path, bool b) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, "");
+	XML::setTextBool(e, b);
 }
 
-void XMLObject::setXMLTextInt(std::string path, int i) {
-	XML::setTextInt(XML::obtainChild(m_element, path), i);
+void XMLObject::setXMLTextInt(std::string_view path, int i) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, "");
+	XML::setTextInt(e, i);
 }
 
-void XMLObject::setXMLTextUInt(std::string path, unsigned int i) {
-	XML::setTextUInt(XML::obtainChild(m_element, path), i);
+void XMLObject::setXMLTextUInt(std::string_view path, unsigned int i) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, "");
+	XML::setTextUInt(e, i);
 }
 
-void XMLObject::setXMLTextFloat(std::string path, float f) {
-	XML::setTextFloat(XML::obtainChild(m_element, path), f);
+void XMLObject::setXMLTextFloat(std::string_view path, float f) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, "");
+	XML::setTextFloat(e, f);
 }
 
-void XMLObject::setXMLTextDouble(std::string path, double d) {
-	XML::setTextDouble(XML::obtainChild(m_element, path), d);
+void XMLObject::setXMLTextDouble(std::string_view path, double d) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, "");
+	XML::setTextDouble(e, d);
 }
 
-void XMLObject::setXMLTextString(std::string path, std::string s) {
-	XML::setTextString(XML::obtainChild(m_element, path), s);
+void XMLObject::setXMLTextString(std::string_view path, std::string_view s) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, "");
+	XML::setTextString(e, s);
 }
 
-void XMLObject::setXMLAttrBool(std::string path, std::string name, bool b) {
-	XML::setAttrBool(XML::obtainChild(m_element, path), name, b);
+void XMLObject::setXMLAttrBool(std::string_view path, std::string_view name, bool b) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, name);
+	XML::setAttrBool(e, name, b);
 }
 
-void XMLObject::setXMLAttrInt(std::string path, std::string name, int i) {
-	XML::setAttrInt(XML::obtainChild(m_element, path), name, i);
+void XMLObject::setXMLAttrInt(std::string_view path, std::string_view name, int i) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, name);
+	XML::setAttrInt(e, name, i);
 }
 
-void XMLObject::setXMLAttrUInt(std::string path, std::string name, unsigned int i) {
-	XML::setAttrUInt(XML::obtainChild(m_element, path), name, i);
+void XMLObject::setXMLAttrUInt(std::string_view path, std::string_view name, unsigned int i) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, name);
+	XML::setAttrUInt(e, name, i);
 }
 
-void XMLObject::setXMLAttrFloat(std::string path, std::string name, float f) {
-	XML::setAttrFloat(XML::obtainChild(m_element, path), name, f);
+void XMLObject::setXMLAttrFloat(std::string_view path, std::string_view name, float f) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, name);
+	XML::setAttrFloat(e, name, f);
 }
 
-void XMLObject::setXMLAttrDouble(std::string path, std::string name, double d) {
-	XML::setAttrDouble(XML::obtainChild(m_element, path), name, d);
+void XMLObject::setXMLAttrDouble(std::string_view path, std::string_view name, double d) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, name);
+	XML::setAttrDouble(e, name, d);
 }
 
-void XMLObject::setXMLAttrString(std::string path, std::string name, std::string s) {
-	XML::setAttrString(XML::obtainChild(m_element, path), name, s);
+void XMLObject::setXMLAttrString(std::string_view path, std::string_view name, std::string_view s) {
+	XMLElement *e = XML::obtainChild(m_element, path);
+	changedXMLValue(e, name);
+	XML::setAttrString(e, name, s);
 }
 
-XMLElement* XMLObject::addXMLChild(std::string path, int index) {
+XMLElement* XMLObject::addXMLChild(std::string_view path, int index) {
+	clearXMLValueCache(); // indices after the new element change
 	return XML::addChild(m_element, path, index);
 }
 
-XMLElement* XMLObject::obtainXMLChild(std::string path, int index) {
+XMLElement* XMLObject::obtainXMLChild(std::string_view path, int index) {
+	changedXMLValue(NULL, "");
 	return XML::obtainChild(m_element, path, index);
 }
 
-void XMLObject::addXMLComment(std::string path, std::string comment) {
+void XMLObject::addXMLComment(std::string_view path, std::string_view comment) {
+	changedXMLValue(NULL, "");
 	XML::addComment(XML::obtainChild(m_element, path), comment);
 }
 
+// VALUE CACHE
+
+void XMLObject::setXMLValueCacheEnabled(bool enabled) {
+	m_valueCacheEnabled = enabled;
+	if(!enabled) {
+		clearXMLValueCache();
+	}
+}
+
+void XMLObject::clearXMLValueCache() {
+	m_valueCache.clear();
+}
+
 // UTIL
 
 bool XMLObject::isXMLDocumentLoaded() {
@@ -669,4 +1128,765 @@ XMLElement* XMLObject::getXMLElement() {
 	return m_element;
 }
 
+// PRIVATE
+
+bool XMLObject::addList(_List *list, std::string_view path, std::string_view name, bool readOnly) {
+	changedXMLStructure();
+	if(name == "") {
+		LOG_WARN << "XML \"" << m_elementName << "\": cannot add list to element \""
+		         << path << "\", name is empty" << std::endl;
+		delete list;
+		return false;
+	}
+	if(list == NULL) {
+		LOG_WARN << "XML \"" << m_elementName << "\": list \"" << name
+		         << "\" vector pointer is NULL" << std::endl;
+		return false;
+	}
+	list->path = path;
+	list->name = name;
+	list->readOnly = readOnly;
+
+	// replace an existing subscription
+	for(unsigned int i = 0; i < m_lists.size(); ++i) {
+		if(m_lists[i]->path == path && m_lists[i]->name == name) {
+			LOG_WARN << "XML \"" << m_elementName << "\": list \"" << name
+			         << "\" at element \"" << path << "\" already subscribed, "
+			         << "resubscribing with new vector pointer" << std::endl;
+			delete m_lists[i];
+			m_lists[i] = list;
+			return true;
+		}
+	}
+	m_lists.push_back(list);
+	return true;
+}
+
+void XMLObject::moveXML(XMLObject &from) {
+
+	// members of the most derived moved-from object are re-pointed to the
+	// same members of this one, both are of the same class
+	ptrdiff_t offset = (const char*) this - (const char*) &from;
+	uintptr_t begin = (uintptr_t) dynamic_cast<const void*>(&from);
+	uintptr_t end = begin + from.getXMLObjectSize();
+
+	// without the object size, members can't be told apart from outside
+	// variables & would be left dangling, this is a programming error: abort
+	// instead of logging as the move constructor must not throw
+	if(begin == end && (!from.m_elements.empty() || !m_elements.empty() || !from.m_lists.empty() ||
+	   !from.m_factories.empty() || !from.m_objects.empty() || from.m_stringArena != NULL)) {
+		fprintf(stderr, "XML \"%s\": cannot move an object with subscriptions, "
+		        "getXMLObjectSize() is not overridden\n", from.m_elementName.c_str());
+		abort();
+	}
+
+	// document
+	m_docLoaded = from.m_docLoaded;
+	m_filename = std::move(from.m_filename);
+	m_xmlDoc = from.m_xmlDoc;
+	m_docResource = from.m_docResource;
+	m_element = from.m_element;
+	m_lazyLoad = from.m_lazyLoad;
+	m_loadPending = from.m_loadPending;
+	from.m_docLoaded = false;
+	from.m_xmlDoc = NULL;
+	from.m_element = NULL;
+	from.m_loadPending = false;
+
+	// published values, unapplied bound values point to the old variables
+	m_snapshotEnabled = from.m_snapshotEnabled;
+	m_snapshot.store(from.m_snapshot.exchange(std::shared_ptr<const XMLSnapshot>()));
+	m_bufferedLoad = from.m_bufferedLoad;
+	m_valuesSequence = from.m_valuesSequence;
+	m_values.store(std::shared_ptr<const XMLBoundValues>());
+	from.m_values.store(std::shared_ptr<const XMLBoundValues>());
+	m_appliedValues = std::move(from.m_appliedValues);
+	m_valueCacheEnabled = from.m_valueCacheEnabled;
+	clearXMLValueCache();
+	from.clearXMLValueCache();
+	m_stringArena = from.m_stringArena;
+	repointXML(m_stringArena, begin, end, offset);
+	m_profile = from.m_profile;
+	m_elementName = std::move(from.m_elementName);
+
+	// subscriptions, the nodes are taken over, the move constructor shares the
+	// resource & operator= has already copied nodes from another resource
+	if(m_elements.get_allocator() == from.m_elements.get_allocator()) {
+		m_elements.swap(from.m_elements);
+	}
+	for(unsigned int i = 0; i < m_elements.size(); ++i) {
+		_Element *e = m_elements[i];
+		repointXML(e->var, begin, end, offset);
+		for(unsigned int j = 0; j < e->attributes.size(); ++j) {
+			repointXML(e->attributes[j]->var, begin, end, offset);
+		}
+	}
+	m_lists.swap(from.m_lists);
+	for(unsigned int i = 0; i < m_lists.size(); ++i) {
+		m_lists[i]->repoint(begin, end, offset);
+	}
+	m_factories.swap(from.m_factories);
+	for(unsigned int i = 0; i < m_factories.size(); ++i) {
+		repointXML(m_factories[i]->factory, begin, end, offset);
+		repointXML(m_factories[i]->objects, begin, end, offset);
+	}
+	m_bindings = from.m_bindings;
+
+	// plans point to the old objects & variables
+	m_planEnabled = from.m_planEnabled;
+	m_plan.clear();
+	m_planElements.clear();
+	m_planObjects.clear();
+	from.m_plan.clear();
+	from.m_planElements.clear();
+	from.m_planObjects.clear();
+	m_structureVersion = from.m_structureVersion;
+	changedXMLStructure();
+	from.changedXMLStructure();
+
+	// attached objects, members are linked to this object before they are moved
+	m_objects.swap(from.m_objects);
+	for(unsigned int i = 0; i < m_objects.size(); ++i) {
+		if(m_objects[i] != NULL && m_objects[i]->m_parent == &from) {
+			m_objects[i]->m_parent = this;
+		}
+		repointXML(m_objects[i], begin, end, offset);
+	}
+
+	// parent, already re-pointed if this object is a member of the moved parent
+	m_parent = from.m_parent;
+	from.m_parent = NULL;
+	if(m_parent != NULL) {
+		std::vector<XMLObject*>::iterator iter;
+		iter = find(m_parent->m_objects.begin(), m_parent->m_objects.end(), &from);
+		if(iter != m_parent->m_objects.end()) {
+			(*iter) = this;
+		}
+		m_parent->changedXMLStructure();
+	}
+}
+
+// hash of a cached value path & attribute name
+static size_t hashXMLValue(std::string_view path, std::string_view name) {
+	std::hash<std::string_view> hash;
+	return hash(path) * 31 + hash(name);
+}
+
+template<class T> XMLResult<T> XMLObject::getXMLCachedValue(std::string_view path, std::string_view name, XMLType type) {
+	size_t hash = hashXMLValue(path, name);
+	auto range = m_valueCache.equal_range(hash);
+	for(auto iter = range.first; iter != range.second; ++iter) {
+		const _CachedValue &cached = iter->second;
+		if(cached.type == type && cached.path == path && cached.name == name) {
+			if constexpr(std::is_same<T, bool>::value) {return XMLResult<T>(cached.value.b, cached.status);}
+			else if constexpr(std::is_same<T, int>::value) {return XMLResult<T>(cached.value.i, cached.status);}
+			else if constexpr(std::is_same<T, unsigned int>::value) {return XMLResult<T>(cached.value.u, cached.status);}
+			else if constexpr(std::is_same<T, float>::value) {return XMLResult<T>(cached.value.f, cached.status);}
+			else if constexpr(std::is_same<T, double>::value) {return XMLResult<T>(cached.value.d, cached.status);}
+			else {return XMLResult<T>(cached.value.s, cached.status);}
+		}
+	}
+
+	// first access, read & convert
+	_CachedValue cached(m_valueCache.get_allocator().resource());
+	cached.path = path;
+	cached.name = name;
+	cached.type = type;
+	cached.element = XML::getChild(m_element, path);
+	XMLResult<T> result = name.empty() ? XML::tryGetText<T>(cached.element) :
+	                                     XML::tryGetAttr<T>(cached.element, cached.name.c_str());
+	cached.status = result.status;
+	if(name.empty()) { // warn once like the uncached reads, later reads are quiet
+		XML::warnTextStatus(result.status, cached.element, type);
+	}
+	else {
+		XML::warnAttrStatus(result.status, cached.element, name, type);
+	}
+	if constexpr(std::is_same<T, bool>::value) {cached.value.b = result.value;}
+	else if constexpr(std::is_same<T, int>::value) {cached.value.i = result.value;}
+	else if constexpr(std::is_same<T, unsigned int>::value) {cached.value.u = result.value;}
+	else if constexpr(std::is_same<T, float>::value) {cached.value.f = result.value;}
+	else if constexpr(std::is_same<T, double>::value) {cached.value.d = result.value;}
+	else {cached.value.s = result.value;}
+	m_valueCache.emplace(hash, std::move(cached));
+	return result;
+}
+
+void XMLObject::changedXMLValue(XMLElement *e, std::string_view name) {
+	std::pmr::unordered_multimap<size_t, _CachedValue>::iterator iter;
+	for(iter = m_valueCache.begin(); iter != m_valueCache.end();) {
+		const _CachedValue &cached = iter->second;
+		if(cached.element == NULL || (cached.element == e && cached.name == name)) {
+			iter = m_valueCache.erase(iter);
+		}
+		else {
+			++iter;
+		}
+	}
+}
+
+void XMLObject::newXMLDocument() {
+	// the document outlives the load, so never take it from a thread resource
+	// which may be a scratch arena reset after each load
+	m_docResource = m_resource ? m_resource : std::pmr::get_default_resource();
+	m_xmlDoc = new(m_docResource->allocate(sizeof(XMLDocument), alignof(XMLDocument))) XMLDocument;
+}
+
+void XMLObject::deleteXMLDocument() {
+	if(m_xmlDoc != NULL) {
+		m_xmlDoc->~XMLDocument();
+		m_docResource->deallocate(m_xmlDoc, sizeof(XMLDocument), alignof(XMLDocument));
+		m_xmlDoc = NULL;
+	}
+}
+
+void XMLObject::loadXMLBindings(XMLElement *e, XMLBoundValues *values) {
+	const std::vector<XMLBindings::Group> &groups = m_bindings->getGroups();
+	for(size_t i = 0; i < groups.size(); ++i) {
+		const XMLBindings::Group &group = groups[i];
+		XMLElement *child = group.path == e->Name() ? e : XML::getChild(e, group.path);
+		if(child == NULL) {
+			continue;
+		}
+		for(size_t j = group.begin; j < group.end; ++j) {
+			const XMLBinding &binding = m_bindings->at(j);
+			void *var = binding.var(this);
+			if(binding.name.empty()) {
+				XML::getText(child, binding.type, values ? values->add(var, binding.type) : var);
+			}
+			else {
+				XML::getAttr(child, binding.name, binding.type, values ? values->add(var, binding.type) : var);
+			}
+			if(binding.type == XML_TYPE_STRING_VIEW && values == NULL) {
+				internView(var);
+			}
+		}
+	}
+}
+
+void XMLObject::saveXMLBindings(XMLElement *e) {
+	const std::vector<XMLBindings::Group> &groups = m_bindings->getGroups();
+	for(size_t i = 0; i < groups.size(); ++i) {
+		const XMLBindings::Group &group = groups[i];
+		XMLElement *child = NULL;
+		for(size_t j = group.begin; j < group.end; ++j) {
+			const XMLBinding &binding = m_bindings->at(j);
+			if(binding.readOnly) {
+				continue;
+			}
+			if(child == NULL) { // find element, add if it doesn't exist
+				child = group.path == e->Name() ? e : XML::obtainChild(e, group.path);
+			}
+			if(binding.name.empty()) {
+				XML::setText(child, binding.type, binding.var(this));
+			}
+			else {
+				XML::setAttr(child, binding.name, binding.type, binding.var(this));
+			}
+			if(binding.type == XML_TYPE_STRING_VIEW) {
+				internView(binding.var(this));
+			}
+		}
+	}
+}
+
+void XMLObject::loadXMLAttributes(XMLElement *e, const _Element *elem, XMLBoundValues *values) {
+	// the values of the usual handful of attributes are found on the stack
+	const char *stackValues[16];
+	std::pmr::vector<const char*> heapValues(getXMLMemoryResource());
+	const char **found = stackValues;
+	if(elem->attributes.size() > 16) {
+		heapValues.resize(elem->attributes.size());
+		found = heapValues.data();
+	}
+	XML::findAttrs(e, elem->attributeIndex, found);
+	for(unsigned int j = 0; j < elem->attributes.size(); ++j) {
+		_Attribute *attr = elem->attributes[j];
+		#ifdef DEBUG_XML_OBJECT
+			LOG_DEBUG << "    attr: " << attr->name << std::endl;
+		#endif
+		XML::convertAttr(e, attr->name, found[j], attr->type, values ? values->add(attr->var, attr->type) : attr->var);
+		if(attr->type == XML_TYPE_STRING_VIEW && values == NULL) {
+			internView(attr->var);
+		}
+	}
+}
+
+void XMLObject::indexXMLAttributes(_Element *elem) {
+	elem->attributeIndex.clear();
+	for(unsigned int j = 0; j < elem->attributes.size(); ++j) {
+		elem->attributeIndex.add(elem->attributes[j]->name);
+	}
+}
+
+void XMLObject::loadXMLLists(XMLElement *e) {
+	for(unsigned int i = 0; i < m_lists.size(); ++i) {
+		_List *list = m_lists[i];
+		XMLElement *parent = (list->path.empty() ? e : XML::getChild(e, list->path));
+		if(parent == NULL) { // no parent, no entries
+			list->resize(0);
+			continue;
+		}
+		const char *name = list->name.c_str();
+		XMLElement *child = parent->FirstChildElement(name);
+
+		// nothing to reuse, so count first to allocate once
+		if(list->size() == 0) {
+			size_t count = 0;
+			for(XMLElement *c = child; c != NULL; c = c->NextSiblingElement(name)) {
+				count++;
+			}
+			list->reserve(count);
+		}
+
+		// fill, reusing existing entries
+		size_t n = 0;
+		for(; child != NULL; child = child->NextSiblingElement(name), ++n) {
+			if(n == list->size()) {
+				list->resize(n+1);
+			}
+			list->load(n, child);
+		}
+		list->resize(n);
+	}
+	if(!m_factories.empty()) {
+		loadXMLFactories(e);
+	}
+}
+
+void XMLObject::saveXMLLists(XMLElement *e) {
+	for(unsigned int i = 0; i < m_lists.size(); ++i) {
+		_List *list = m_lists[i];
+		if(list->readOnly) {
+			continue;
+		}
+		XMLElement *parent = (list->path.empty() ? e : XML::obtainChild(e, list->path));
+		const char *name = list->name.c_str();
+		XMLElement *child = parent->FirstChildElement(name);
+
+		// overwrite existing elements in order, add missing ones at the end
+		for(size_t n = 0; n < list->size(); ++n) {
+			if(child == NULL) {
+				XML_PROFILE_COUNT(elementsCreated, 1);
+				child = e->GetDocument()->NewElement(name);
+				parent->InsertEndChild(child);
+			}
+			list->save(n, child);
+			child = child->NextSiblingElement(name);
+		}
+
+		// remove surplus elements
+		while(child != NULL) {
+			XMLElement *next = child->NextSiblingElement(name);
+			parent->DeleteChild(child);
+			child = next;
+		}
+	}
+	if(!m_factories.empty()) {
+		saveXMLFactories(e);
+	}
+}
+
+void XMLObject::loadXMLFactories(XMLElement *e) {
+	for(unsigned int i = 0; i < m_factories.size(); ++i) {
+		_Factory *f = m_factories[i];
+		std::vector<XMLObject*> &objects = *f->objects;
+		XMLElement *parent = (f->path.empty() ? e : XML::getChild(e, f->path));
+		XMLElement *first = (parent ? nextXMLFactoryChild(f->factory, parent->FirstChildElement()) : NULL);
+
+		// keep the object at each position if the element name is unchanged,
+		// release the others & the surplus objects before obtaining any so
+		// the pool can serve the new positions
+		size_t n = 0;
+		for(XMLElement *child = first; child != NULL;
+		    child = nextXMLFactoryChild(f->factory, child->NextSiblingElement())) {
+			if(n < objects.size() && objects[n]->getXMLName() != child->Name()) {
+				f->factory->release(objects[n]);
+				objects[n] = NULL;
+			}
+			n++;
+		}
+		for(size_t j = n; j < objects.size(); ++j) {
+			f->factory->release(objects[j]);
+		}
+		objects.resize(n, NULL);
+
+		// obtain objects for the released & new positions & load
+		n = 0;
+		for(XMLElement *child = first; child != NULL;
+		    child = nextXMLFactoryChild(f->factory, child->NextSiblingElement())) {
+			if(objects[n] == NULL) {
+				objects[n] = f->factory->obtain(child->Name());
+			}
+			objects[n]->loadXML(child);
+			n++;
+		}
+	}
+}
+
+void XMLObject::saveXMLFactories(XMLElement *e) {
+	for(unsigned int i = 0; i < m_factories.size(); ++i) {
+		_Factory *f = m_factories[i];
+		if(f->readOnly) {
+			continue;
+		}
+		std::vector<XMLObject*> &objects = *f->objects;
+		XMLElement *parent = (f->path.empty() ? e : XML::obtainChild(e, f->path));
+		XMLElement *child = nextXMLFactoryChild(f->factory, parent->FirstChildElement());
+		XMLElement *prev = NULL;
+
+		// overwrite existing elements in order, insert an element where the
+		// name differs & add missing ones at the end
+		for(size_t n = 0; n < objects.size(); ++n) {
+			const std::string &name = objects[n]->getXMLName();
+			XMLElement *target = child;
+			if(target == NULL || name != target->Name()) {
+				XML_PROFILE_COUNT(elementsCreated, 1);
+				target = e->GetDocument()->NewElement(name.c_str());
+				if(child == NULL) {
+					parent->InsertEndChild(target);
+				}
+				else if(prev == NULL) {
+					parent->InsertFirstChild(target);
+				}
+				else {
+					parent->InsertAfterChild(prev, target);
+				}
+			}
+			else {
+				child = nextXMLFactoryChild(f->factory, child->NextSiblingElement());
+			}
+			objects[n]->saveXML(target);
+			prev = target;
+		}
+
+		// remove surplus registered elements
+		while(child != NULL) {
+			XMLElement *next = nextXMLFactoryChild(f->factory, child->NextSiblingElement());
+			parent->DeleteChild(child);
+			child = next;
+		}
+	}
+}
+
+XMLElement* XMLObject::nextXMLFactoryChild(XMLObjectFactory *factory, XMLElement *e) {
+	while(e != NULL && !factory->hasType(e->Name())) {
+		e = e->NextSiblingElement();
+	}
+	return e;
+}
+
+// ns to ms
+static double ms(uint64_t ns) {
+	return ns / 1000000.0;
+}
+
+// compiled plans
+
+void XMLObject::updateXMLPlan() {
+	bool valid = !m_planObjects.empty();
+	for(size_t i = 0; valid && i < m_planObjects.size(); ++i) {
+		valid = (m_planObjects[i].first->m_structureVersion == m_planObjects[i].second);
+	}
+	if(valid) {
+		return;
+	}
+	m_plan.clear();
+	m_planObjects.clear();
+	unsigned int maxDepth = 0;
+	addXMLPlanSteps(m_plan, 0, maxDepth, m_planObjects);
+	m_planElements.assign(maxDepth+1, NULL);
+
+	// versions are taken afterwards as removed NULL objects change them
+	for(size_t i = 0; i < m_planObjects.size(); ++i) {
+		m_planObjects[i].second = m_planObjects[i].first->m_structureVersion;
+	}
+}
+
+void XMLObject::addXMLPlanSteps(std::vector<_Step> &plan, unsigned int depth, unsigned int &maxDepth,
+                                std::vector<std::pair<XMLObject*, unsigned long>> &objects) {
+	objects.push_back(std::make_pair(this, 0));
+	if(depth > maxDepth) {
+		maxDepth = depth;
+	}
+
+	// subscribed elements & attributes
+	for(unsigned int i = 0; i < m_elements.size(); ++i) {
+		_Element *elem = m_elements[i];
+		size_t element = plan.size();
+		plan.push_back(_Step(_Step::ELEMENT, this, depth, elem->path));
+		if(elem->var != NULL) {
+			_Step step(_Step::TEXT, this, depth);
+			step.type = elem->type;
+			step.var = elem->var;
+			step.readOnly = elem->readOnly;
+			plan.push_back(step);
+		}
+		for(unsigned int j = 0; j < elem->attributes.size(); ++j) {
+			_Attribute *attr = elem->attributes[j];
+			_Step step(_Step::ATTR, this, depth, attr->name);
+			step.type = attr->type;
+			step.var = attr->var;
+			step.readOnly = attr->readOnly;
+			plan.push_back(step);
+		}
+		plan[element].end = plan.size();
+		if(!elem->attributes.empty()) {
+			plan[element].element = elem;
+		}
+	}
+
+	// binding table, the element is only obtained when saving if a value is written
+	if(m_bindings != NULL) {
+		const std::vector<XMLBindings::Group> &groups = m_bindings->getGroups();
+		for(size_t i = 0; i < groups.size(); ++i) {
+			const XMLBindings::Group &group = groups[i];
+			size_t element = plan.size();
+			plan.push_back(_Step(_Step::ELEMENT, this, depth, group.path));
+			plan[element].readOnly = true;
+			for(size_t j = group.begin; j < group.end; ++j) {
+				const XMLBinding &binding = m_bindings->at(j);
+				_Step step(binding.name.empty() ? _Step::TEXT : _Step::ATTR, this, depth, binding.name);
+				step.type = binding.type;
+				step.var = binding.var(this);
+				step.readOnly = binding.readOnly;
+				plan[element].readOnly = plan[element].readOnly && binding.readOnly;
+				plan.push_back(step);
+			}
+			plan[element].end = plan.size();
+		}
+	}
+	plan.push_back(_Step(_Step::LISTS, this, depth));
+
+	// attached objects, indices are counted per element name like saveXML
+	std::pmr::map<std::string_view, int> elementMap(getXMLMemoryResource());
+	std::vector<XMLObject*>::iterator objectIter;
+	for(objectIter = m_objects.begin(); objectIter != m_objects.end();) {
+		XMLObject *object = (*objectIter);
+		if(object == NULL) {
+			objectIter = m_objects.erase(objectIter);
+			changedXMLStructure();
+			LOG_WARN << "XML \"" << m_elementName << "\" plan: removed NULL xml object" << std::endl;
+			continue;
+		}
+		int index = 0;
+		if(!object->getXMLName().empty()) {
+			std::pmr::map<std::string_view, int>::iterator iter = elementMap.find(object->getXMLName());
+			if(iter == elementMap.end()) {
+				elementMap.insert(make_pair(std::string_view(object->getXMLName()), 0));
+			}
+			else {
+				index = ++iter->second;
+			}
+		}
+		if(object->m_lazyLoad) { // only the name & lazy flag are compiled
+			objects.push_back(std::make_pair(object, 0));
+			_Step step(_Step::DEFER, object, depth, object->getXMLName());
+			step.index = index;
+			plan.push_back(step);
+		}
+		else {
+			size_t enter = plan.size();
+			plan.push_back(_Step(_Step::ENTER, object, depth, object->getXMLName()));
+			plan[enter].index = index;
+			object->addXMLPlanSteps(plan, depth+1, maxDepth, objects);
+			plan.push_back(_Step(_Step::LEAVE, object, depth+1));
+			plan[enter].end = plan.size();
+		}
+		++objectIter;
+	}
+}
+
+void XMLObject::runXMLLoadPlan(XMLElement *e) {
+	updateXMLPlan();
+	m_planElements[0] = e;
+	XMLElement *current = NULL;
+	const _Element *indexed = NULL; // subscribed element whose attributes were loaded
+	XML_PROFILE_MARK(mark);
+	for(size_t i = 0; i < m_plan.size();) {
+		const _Step &step = m_plan[i];
+		XMLElement *parent = m_planElements[step.depth];
+		switch(step.op) {
+			case _Step::ENTER:
+			case _Step::DEFER: {
+				XMLElement *child = parent;
+				if(!step.name.empty() && step.name != parent->Name()) {
+					child = XML::getChild(parent, step.name, step.index);
+				}
+				if(child == NULL) {
+					LOG_WARN << "XMLObject: element not found for \""
+					         << step.name << "\" object" << std::endl;
+					if(step.op == _Step::ENTER) {
+						i = step.end;
+						continue;
+					}
+					break;
+				}
+				step.object->resetXMLElement(child);
+				if(step.op == _Step::DEFER) { // loaded on first ensureXMLLoaded()
+					step.object->m_loadPending = true;
+					break;
+				}
+				step.object->m_loadPending = false;
+				m_planElements[step.depth+1] = child;
+				XML_PROFILE_CALL(step.object->m_profile.load);
+				XML_PROFILE_RESET(mark);
+				break;
+			}
+
+			case _Step::ELEMENT:
+				current = (step.name == parent->Name() ? parent : XML::getChild(parent, step.name));
+				if(current == NULL) {
+					i = step.end;
+					continue;
+				}
+				indexed = step.element;
+				if(indexed != NULL) {
+					step.object->loadXMLAttributes(current, indexed, NULL);
+				}
+				break;
+
+			case _Step::TEXT:
+				XML::getText(current, step.type, step.var);
+				if(step.type == XML_TYPE_STRING_VIEW) {
+					step.object->internView(step.var);
+				}
+				break;
+
+			case _Step::ATTR:
+				if(indexed != NULL) { // already loaded by the element step
+					break;
+				}
+				XML::getAttr(current, step.name, step.type, step.var);
+				if(step.type == XML_TYPE_STRING_VIEW) {
+					step.object->internView(step.var);
+				}
+				break;
+
+			case _Step::LISTS:
+				step.object->loadXMLLists(parent);
+				XML_PROFILE_ADD(mark, step.object->m_profile.load, subscriptionTime);
+				break;
+
+			case _Step::LEAVE: {
+				XML_PROFILE_RESET(mark);
+				XML_TRACE_BEGIN(callbackSpan, "readXML", step.object->m_elementName);
+				step.object->readXML(parent);
+				XML_TRACE_END(callbackSpan);
+				XML_PROFILE_ADD(mark, step.object->m_profile.load, callbackTime);
+				break;
+			}
+		}
+		++i;
+	}
+}
+
+void XMLObject::runXMLSavePlan(XMLElement *e) {
+	updateXMLPlan();
+	m_planElements[0] = e;
+	XMLElement *current = NULL;
+	XML_PROFILE_MARK(mark);
+	for(size_t i = 0; i < m_plan.size();) {
+		const _Step &step = m_plan[i];
+		XMLElement *parent = m_planElements[step.depth];
+		switch(step.op) {
+			case _Step::ENTER:
+			case _Step::DEFER: {
+				XMLElement *child = parent;
+				if(!step.name.empty()) {
+					child = XML::obtainChild(parent, step.name, step.index);
+				}
+				if(step.op == _Step::DEFER || step.object->m_loadPending) {
+					step.object->saveXML(child); // saves itself after a pending lazy load
+					if(step.op == _Step::ENTER) {
+						i = step.end;
+						continue;
+					}
+					break;
+				}
+				step.object->resetXMLElement(child);
+				m_planElements[step.depth+1] = child;
+				XML_PROFILE_CALL(step.object->m_profile.save);
+				XML_PROFILE_RESET(mark);
+				break;
+			}
+
+			case _Step::ELEMENT:
+				if(step.readOnly) { // nothing to write, don't create the element
+					i = step.end;
+					continue;
+				}
+				current = (step.name == parent->Name() ? parent : XML::obtainChild(parent, step.name));
+				break;
+
+			case _Step::TEXT:
+				if(!step.readOnly) {
+					XML::setText(current, step.type, step.var);
+					if(step.type == XML_TYPE_STRING_VIEW) {
+						step.object->internView(step.var);
+					}
+				}
+				break;
+
+			case _Step::ATTR:
+				if(!step.readOnly) {
+					XML::setAttr(current, step.name, step.type, step.var);
+					if(step.type == XML_TYPE_STRING_VIEW) {
+						step.object->internView(step.var);
+					}
+				}
+				break;
+
+			case _Step::LISTS:
+				step.object->saveXMLLists(parent);
+				XML_PROFILE_ADD(mark, step.object->m_profile.save, subscriptionTime);
+				break;
+
+			case _Step::LEAVE: {
+				XML_PROFILE_RESET(mark);
+				XML_TRACE_BEGIN(callbackSpan, "writeXML", step.object->m_elementName);
+				step.object->writeXML(parent);
+				XML_TRACE_END(callbackSpan);
+				XML_PROFILE_ADD(mark, step.object->m_profile.save, callbackTime);
+				break;
+			}
+		}
+		++i;
+	}
+}
+
+void XMLObject::addXMLProfileRows(std::ostream &stream, unsigned int depth) {
+	const XMLProfile::Counters &load = m_profile.load, &save = m_profile.save;
+	std::string name = std::string(depth * 2, ' ') +
+		(m_elementName.empty() ? "(parent)" : m_elementName);
+	stream << std::left << std::setw(24) << name << std::right
+	       << std::fixed << std::setprecision(3)
+	       << std::setw(8) << load.calls << std::setw(10) << ms(load.fileTime)
+	       << std::setw(10) << ms(load.subscriptionTime) << std::setw(10) << ms(load.objectTime)
+	       << std::setw(10) << ms(load.callbackTime) << std::setw(8) << load.pathResolutions
+	       << std::setw(10) << load.siblingSteps
+	       << std::setw(8) << save.calls << std::setw(10) << ms(save.fileTime)
+	       << std::setw(10) << ms(save.subscriptionTime) << std::setw(10) << ms(save.objectTime)
+	       << std::setw(10) << ms(save.callbackTime) << std::setw(8) << save.pathResolutions
+	       << std::setw(10) << save.siblingSteps << std::setw(10) << save.elementsCreated
+	       << std::endl;
+	for(unsigned int i = 0; i < m_objects.size(); ++i) {
+		if(m_objects[i] != NULL) {
+			m_objects[i]->addXMLProfileRows(stream, depth+1);
+		}
+	}
+}
+
+void XMLObject::cancelXMLLoad() {
+	if(m_loadPending) {
+		resetXMLElement(NULL);
+		m_loadPending = false;
+	}
+	for(unsigned int i = 0; i < m_objects.size(); ++i) {
+		if(m_objects[i] != NULL) {
+			m_objects[i]->cancelXMLLoad();
+		}
+	}
+}
+
 } // namespace
@@ -23,10 +23,56 @@
 #pragma once
 
 #include "XML.h"
+#include "XMLBinding.h"
+#include "XMLBoundValues.h"
+#include "XMLObjectFactory.h"
+#include "XMLPublished.h"
+#include "XMLSnapshot.h"
+#include "XMLStringArena.h"
+#include <iosfwd>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace tinyxml2 {
 
+/// load/save profiling counters for a single XMLObject, only updated when the
+/// library is built with TINYOBJECT_PROFILE defined (configure --enable-profile)
+struct XMLProfile {
+
+	/// loading or saving counters, times are in ns
+	struct Counters {
+		unsigned long calls; ///< number of loads or saves
+		uint64_t fileTime; ///< file read & parse or print & write
+		uint64_t subscriptionTime; ///< subscribed elements & attributes
+		uint64_t objectTime; ///< attached objects, includes their own times
+		uint64_t callbackTime; ///< readXML or writeXML callback
+		unsigned long pathResolutions; ///< element paths resolved
+		unsigned long siblingSteps; ///< sibling elements walked to reach an index
+		unsigned long elementsCreated; ///< elements created by obtainChild or addChild
+
+		Counters() {clear();}
+
+		/// reset to 0
+		void clear() {
+			calls = 0;
+			fileTime = subscriptionTime = objectTime = callbackTime = 0;
+			pathResolutions = siblingSteps = elementsCreated = 0;
+		}
+	};
+
+	Counters load; ///< loadXML & loadXMLFile counters
+	Counters save; ///< saveXML & saveXMLFile counters
+
+	/// reset to 0
+	void clear() {
+		load.clear();
+		save.clear();
+	}
+};
+
 /// \class XMLObject
 /// \brief an xml object baseclass to split up xml processing per class
 ///
@@ -43,9 +89,44 @@ class XMLObject {
 	public:
 
 		/// set the xml element name, if the element is empty the element name of the parent is used
-		XMLObject(std::string elementName="");
+		///
+		/// resource is used for the subscription nodes, the document & the
+		/// temporaries of each load/save & is set as the thread's resource
+		/// while loading & saving, NULL uses the thread's resource: subscription
+		/// nodes come from the resource current at construction & temporaries
+		/// from the one current when loading/saving, the document is kept until
+		/// closed so it comes from std::pmr::get_default_resource() instead,
+		/// see XML::setMemoryResource()
+		XMLObject(std::string elementName="", std::pmr::memory_resource *resource=NULL);
 		virtual ~XMLObject();
 
+		/// objects cannot be copied, moving transfers the document,
+		/// subscriptions, attached objects & the link to the parent object so
+		/// objects can be stored in place, ie. std::vector<MyObject>,
+		/// the moved-from object is left empty
+		///
+		/// subscribed variables, lists, factories & attached objects which are
+		/// members of the object are re-pointed to the moved object, this
+		/// needs getXMLObjectSize() to be overridden by every class which is
+		/// moved: moving an object with subscriptions, lists, factories,
+		/// attached objects or a string arena without it is a programming
+		/// error which aborts, as they would be left pointing into the
+		/// moved-from object, subscribeXMLList() checks this at compile time
+		///
+		/// move construction takes over the subscription nodes & does not
+		/// allocate, move assignment copies them if the objects were
+		/// constructed with different memory resources
+		///
+		/// binding tables always follow the object, published bound values
+		/// which were not applied yet are dropped & compiled plans are rebuilt
+		/// on the next load/save
+		///
+		/// only move between objects of the same class, moving is not thread safe
+		XMLObject(XMLObject &&from) noexcept;
+		XMLObject& operator=(XMLObject &&from);
+		XMLObject(const XMLObject &from) = delete;
+		XMLObject& operator=(const XMLObject &from) = delete;
+
 		/// initialize an empty xml document with a root element matching this
 		/// object's element name,
 		/// only needed when setting data externally before saving if you're not
@@ -77,22 +158,140 @@ class XMLObject {
 		/// attach/remove an XmlObject to this one,
 		/// attached object readXML & writeXML functions are called when this
 		/// object is loaded or saved
+		///
+		/// an object keeps a link to the object it was last attached to &
+		/// detaches itself when destroyed or updates the parent when moved
 		void addXMLObject(XMLObject *object);
 		void removeXMLObject(XMLObject *object);
 
+		/// enable/disable lazy loading when this object is attached to a parent,
+		/// the parent then only records the element for this object when loading
+		/// and subscriptions & readXML are deferred until ensureXMLLoaded() is called,
+		/// default: false
+		inline void setXMLLazyLoad(bool lazy) {m_lazyLoad = lazy; changedXMLStructure();}
+		inline bool getXMLLazyLoad() {return m_lazyLoad;}
+
+		/// load this object from the element recorded by its parent if a lazy
+		/// load is pending, returns true if the object is loaded
+		bool ensureXMLLoaded();
+
+		/// returns true if this object has a recorded element which has not
+		/// been loaded yet
+		inline bool isXMLLoadPending() {return m_loadPending;}
+
+	/// \section Compiled Plans
+
+		/// enable/disable loading & saving via a compiled plan, default: false
+		///
+		/// when enabled, this object & all attached objects are compiled into
+		/// a flat list of steps (find element, read/write value, callback)
+		/// which is run in a single loop, the plan is rebuilt when objects or
+		/// subscriptions change in any of the compiled objects
+		///
+		/// buffered loads don't use the plan, lazy objects & pending lazy
+		/// saves fall back to their own loadXML/saveXML & lists are handled by
+		/// the object they belong to, objectTime is not profiled for objects
+		/// loaded or saved by a plan
+		///
+		/// callbacks must not attach or remove objects while a plan is running
+		inline void setXMLPlanEnabled(bool enabled) {m_planEnabled = enabled;}
+		inline bool getXMLPlanEnabled() {return m_planEnabled;}
+
+	/// \section Profiling
+
+		/// returns true if the library was built with profiling enabled
+		static bool isXMLProfileEnabled();
+
+		/// get the profiling counters for this object,
+		/// paths, sibling steps & created elements only count work done
+		/// by this object, not its attached objects,
+		/// the counters stay at 0 if profiling is not enabled
+		inline const XMLProfile& getXMLProfile() {return m_profile;}
+
+		/// reset the profiling counters for this object & attached objects
+		void resetXMLProfile();
+
+		/// format the profiling counters for this object & attached objects
+		/// as a text table with one row per object, times are in ms,
+		/// returns an empty string if profiling is not enabled
+		std::string getXMLProfileTable();
+
+	/// \section Snapshots
+
+		/// enable/disable publishing a read-only snapshot of the document each
+		/// time it is loaded with loadXMLFile(), default: false
+		inline void setXMLSnapshotEnabled(bool enabled) {m_snapshotEnabled = enabled;}
+		inline bool getXMLSnapshotEnabled() {return m_snapshotEnabled;}
+
+		/// publish a snapshot of the current document, replaces the previous
+		/// snapshot which is released when its last reader drops it
+		/// does nothing if the document is not loaded
+		void publishXMLSnapshot();
+
+		/// get the most recently published snapshot,
+		/// can be called from any thread while the document is reloaded,
+		/// does not lock, see XMLPublished,
+		/// returns an empty pointer if nothing has been published
+		std::shared_ptr<const XMLSnapshot> getXMLSnapshot() const;
+
+	/// \section Buffered Loading
+
+		/// enable/disable buffered loading, default: false
+		///
+		/// when enabled, loadXML() decodes the subscribed values of this object
+		/// and all attached objects into a new XMLBoundValues set instead of
+		/// writing the subscribed variables in place, the set is then published
+		/// as a whole so readers on other threads never see a partial load
+		inline void setXMLBufferedLoad(bool buffered) {m_bufferedLoad = buffered;}
+		inline bool getXMLBufferedLoad() {return m_bufferedLoad;}
+
+		/// get the most recently published bound values,
+		/// can be called from any thread while the document is reloaded,
+		/// does not lock, see XMLPublished,
+		/// returns an empty pointer if nothing has been published
+		std::shared_ptr<const XMLBoundValues> getXMLBoundValues() const;
+
+		/// copy the most recently published bound values into the subscribed
+		/// variables, only call this from the thread which owns the variables
+		/// the set is kept until the next call as applied string views point into it
+		void applyXMLBoundValues();
+
+	/// \section String Views
+
+		/// set/get the arena to copy XML_TYPE_STRING_VIEW values of this object
+		/// into when loading & saving, the arena is not owned, default: NULL
+		///
+		/// without an arena, loaded views point straight into the document
+		/// text & are only valid until the document is closed or reloaded,
+		/// saving re-points them to the newly written text,
+		/// buffered loads always copy views into the published value set
+		inline void setXMLStringArena(XMLStringArena *arena) {m_stringArena = arena;}
+		inline XMLStringArena* getXMLStringArena() {return m_stringArena;}
+
+	/// \section Memory
+
+		/// get the memory resource for the temporaries of a load/save,
+		/// the resource set in the constructor or the thread's resource
+		inline std::pmr::memory_resource* getXMLMemoryResource() {
+			return m_resource ? m_resource : XML::getMemoryResource();
+		}
+
 	/// \section Elements
 
 		/// subscribe to automatically load/save an element at a path relative
 		/// to the current level
 		/// path can also be a / separated string to denote multiple levels of depth below the given
 		/// element aka "sub/element/test"
+		/// var must point to a variable of the given type, ie. std::vector<float>
+		/// for XML_TYPE_FLOAT_ARRAY or std::string_view for XML_TYPE_STRING_VIEW,
+		/// see setXMLStringArena()
 		/// returns true on success
-		bool subscribeXMLElement(std::string path, XMLType type, void *var, bool readOnly=false);
+		bool subscribeXMLElement(std::string_view path, XMLType type, void *var, bool readOnly=false);
 	
 		/// unsubscribe a subscribed element at a path relative to the current level,
 		/// also removes attached attributes to this element
 		/// returns true on success
-		bool unsubscribeXMLElement(std::string path);
+		bool unsubscribeXMLElement(std::string_view path);
 	
 		/// unsubscribe all subscribed elements, also removes subscribed attributes
 		void unsubscribeAllXMLElements();
@@ -107,65 +306,181 @@ class XMLObject {
 		/// path can also be a / separated string to denote multiple levels of depth below the given
 		/// element aka "sub/element/test"
 		/// returns true on success
-		bool subscribeXMLAttribute(std::string path, std::string name, XMLType type, void *var, bool readOnly=false);
+		bool subscribeXMLAttribute(std::string_view path, std::string_view name, XMLType type, void *var, bool readOnly=false);
 	
 		/// unsubscribe a subscribed attribute in an element at a path relative to the current level
 		/// returns true on success
-		bool unsubscribeXMLAttribute(std::string path, std::string name);
+		bool unsubscribeXMLAttribute(std::string_view path, std::string_view name);
 	
 		/// unsubscribe all attributes, also removes elements that were not *explicityl* subscribed
 		/// to via subscribeXMLElement()
 		void unsubscribeAllXMLAttributes();
 	
+	/// \section Lists
+
+		/// subscribe to automatically load/save the repeated child elements with
+		/// the given name below the element at a path into a vector,
+		/// ie. path "points" & name "point" for <points><point>1</point>...
+		/// leave the path empty "" to use the element of this object
+		///
+		/// loading fills the vector in a single walk over the children & reuses
+		/// the existing entries, saving writes the entries back in order & removes
+		/// surplus elements
+		///
+		/// lists are always loaded in place & are skipped by buffered loading
+		///
+		/// values: T is any type with an XMLType, ie. float or std::string,
+		/// std::string_view entries always point into the document text
+		/// returns true on success
+		///
+		/// objects: T is an XMLObject subclass with a default constructor,
+		/// objects are created as needed & loaded/saved with their own
+		/// subscriptions & callbacks, objects in a std::vector<T> are stored in
+		/// place & are moved when the vector grows so T must override
+		/// getXMLObjectSize(), see XMLObject(XMLObject&&)
+		/// returns true on success
+		template<class T> bool subscribeXMLList(std::string_view path, std::string_view name,
+		                                        std::vector<T> *list, bool readOnly=false) {
+			if constexpr(std::is_base_of<XMLObject, T>::value) {
+				static_assert(_HasObjectSize<T>::check(),
+				              "list objects stored in place are moved, T must override getXMLObjectSize()");
+				return addList(list ? new _InPlaceList<T>(list) : NULL, path, name, readOnly);
+			}
+			else {
+				static_assert(XMLTypeOf<T>::type != XML_TYPE_UNDEF, "unsupported list value type");
+				return addList(list ? new _ValueList<T>(list) : NULL, path, name, readOnly);
+			}
+		}
+
+		/// objects in a std::vector<std::unique_ptr<T>> are heap allocated
+		/// returns true on success
+		template<class T> bool subscribeXMLList(std::string_view path, std::string_view name,
+		                                        std::vector<std::unique_ptr<T>> *list, bool readOnly=false) {
+			static_assert(std::is_base_of<XMLObject, T>::value, "list objects must be XMLObject subclasses");
+			return addList(list ? new _ObjectList<T>(list) : NULL, path, name, readOnly);
+		}
+
+		/// unsubscribe a subscribed list by path & element name
+		/// returns true on success
+		bool unsubscribeXMLList(std::string_view path, std::string_view name);
+
+		/// unsubscribe all lists
+		void unsubscribeAllXMLLists();
+
+	/// \section Factories
+
+		/// subscribe to automatically load/save the child elements below the
+		/// element at a path whose names are registered in a factory into a
+		/// vector of objects, in document order,
+		/// leave the path empty "" to use the element of this object
+		///
+		/// loading keeps the object at each position if its element name is
+		/// unchanged, so objects are the same across reloads when the elements
+		/// are, the other & surplus objects are released to the factory before
+		/// new ones are obtained, so reloading a set of elements seen before
+		/// creates no objects, saving works like a list
+		///
+		/// factory objects are loaded & saved with lists & are skipped by
+		/// buffered loading
+		/// returns true on success
+		bool subscribeXMLFactory(std::string_view path, XMLObjectFactory *factory,
+		                         std::vector<XMLObject*> *objects, bool readOnly=false);
+
+		/// unsubscribe a subscribed factory by path, the objects stay in the
+		/// vector & are still owned by the factory
+		/// returns true on success
+		bool unsubscribeXMLFactory(std::string_view path);
+
+		/// unsubscribe all factories
+		void unsubscribeAllXMLFactories();
+
+	/// \section Bindings
+
+		/// set/get a per-class binding table, loaded & saved like subscribed
+		/// elements & attributes, the table is not owned & is usually a static
+		/// shared by all objects of the class, see XMLBindings
+		/// default: NULL
+		///
+		/// returns false & keeps the current table if the table binds members
+		/// of a class this object is not derived from
+		bool setXMLBindings(const XMLBindings *bindings);
+		inline const XMLBindings* getXMLBindings() {return m_bindings;}
+
+	/// \section Value Cache
+
+		/// enable/disable caching the converted values read by the getXMLText*
+		/// & getXMLAttr* functions per path, attribute & type, repeated reads
+		/// are then a hash lookup without walking the path or converting,
+		/// failed reads are cached as well & return the given default value,
+		/// disabling clears the cache, default: false
+		///
+		/// the cache is cleared whenever the element of this object is loaded,
+		/// saved or replaced & the setXMLText* & setXMLAttr* functions invalidate
+		/// the values of the element they change, call clearXMLValueCache()
+		/// after changing the document directly, ie. via getXMLElement()
+		void setXMLValueCacheEnabled(bool enabled);
+		inline bool getXMLValueCacheEnabled() {return m_valueCacheEnabled;}
+
+		/// remove all cached values
+		void clearXMLValueCache();
+
 	/// \section Data Access
 	/// these member functions only work when the current element is set via loadXML/initXML
 	
 		/// element text access by type,
 		/// returns value on success or defaultVal if wrong type
-		bool getXMLTextBool(std::string path, bool defaultVal=false);
-		int getXMLTextInt(std::string path, int defaultVal=0);
-		unsigned int getXMLTextUInt(std::string path, unsigned int defaultVal=0);
-		float getXMLTextFloat(std::string path, float defaultVal=0.0f);
-		double getXMLTextDouble(std::string path, double defaultVal=0.0);
-		std::string getXMLTextString(std::string path, std::string defaultVal="");
+		bool getXMLTextBool(std::string_view path, bool defaultVal=false);
+		int getXMLTextInt(std::string_view path, int defaultVal=0);
+		unsigned int getXMLTextUInt(std::string_view path, unsigned int defaultVal=0);
+		float getXMLTextFloat(std::string_view path, float defaultVal=0.0f);
+		double getXMLTextDouble(std::string_view path, double defaultVal=0.0);
+		std::string getXMLTextString(std::string_view path, std::string_view defaultVal="");
+
+		/// element text as a view into the document, does not allocate,
+		/// the view is valid until the element is changed or the document closed
+		std::string_view getXMLTextView(std::string_view path, std::string_view defaultVal="");
 	
 		/// element attribute access by type
 		/// returns value on success or defaultVal if attribute not found or wrong type
-		bool getXMLAttrBool(std::string path, std::string name, bool defaultVal=false);
-		int getXMLAttrInt(std::string path, std::string name, int defaultVal=0);
-		unsigned int getXMLAttrUInt(std::string path, std::string name, unsigned int defaultVal=0);
-		float getXMLAttrFloat(std::string path, std::string name, float defaultVal=0.0f);
-		double getXMLAttrDouble(std::string path, std::string name, double defaultVal=0.0);
-		std::string getXMLAttrString(std::string path, std::string name, std::string defaultVal="");
+		bool getXMLAttrBool(std::string_view path, std::string_view name, bool defaultVal=false);
+		int getXMLAttrInt(std::string_view path, std::string_view name, int defaultVal=0);
+		unsigned int getXMLAttrUInt(std::string_view path, std::string_view name, unsigned int defaultVal=0);
+		float getXMLAttrFloat(std::string_view path, std::string_view name, float defaultVal=0.0f);
+		double getXMLAttrDouble(std::string_view path, std::string_view name, double defaultVal=0.0);
+		std::string getXMLAttrString(std::string_view path, std::string_view name, std::string_view defaultVal="");
+
+		/// element attribute as a view into the document, does not allocate,
+		/// the view is valid until the element is changed or the document closed
+		std::string_view getXMLAttrView(std::string_view path, std::string_view name, std::string_view defaultVal="");
 	
 		/// find child element by path and index (if in a list), returns NULL if element not found
 		/// path can also be a / separated string to denote multiple levels of depth below the given
 		/// element aka "/sub/element/test" or "/sub/1/element/2/test"
 		/// if an index is given for the final element in the path along with an index argument, the greater of
 		/// the two is used
-		XMLElement* getXMLChild(std::string path, int index=0);
+		XMLElement* getXMLChild(std::string_view path, int index=0);
 	
 		/// get the number of child elements with the given name,
 		/// if name is empty "", returns total number of child elements
 		/// path can also be a / separated string to denote multiple levels of depth below the given
 		/// element aka "sub/element/test" or "/sub/1/element/2/test"
-		unsigned int getNumXMLChildren(std::string path, std::string name="");
+		unsigned int getNumXMLChildren(std::string_view path, std::string_view name="");
 	
 		/// set the element text
-		void setXMLTextBool(std::string path, bool b);
-		void setXMLTextInt(std::string path, int i);
-		void setXMLTextUInt(std::string path, unsigned int i);
-		void setXMLTextFloat(std::string path, float f);
-		void setXMLTextDouble(std::string path, double d);
-		void setXMLTextString(std::string path, std::string s);
+		void setXMLTextBool(std::string_view path, bool b);
+		void setXMLTextInt(std::string_view path, int i);
+		void setXMLTextUInt(std::string_view path, unsigned int i);
+		void setXMLTextFloat(std::string_view path, float f);
+		void setXMLTextDouble(std::string_view path, double d);
+		void setXMLTextString(std::string_view path, std::string_view s);
 	
 		/// set element attributes by type
-		void setXMLAttrBool(std::string path, std::string name, bool b);
-		void setXMLAttrInt(std::string path, std::string name, int i);
-		void setXMLAttrUInt(std::string path, std::string name, unsigned int i);
-		void setXMLAttrFloat(std::string path, std::string name, float f);
-		void setXMLAttrDouble(std::string path, std::string name, double d);
-		void setXMLAttrString(std::string path, std::string name, std::string s);
+		void setXMLAttrBool(std::string_view path, std::string_view name, bool b);
+		void setXMLAttrInt(std::string_view path, std::string_view name, int i);
+		void setXMLAttrUInt(std::string_view path, std::string_view name, unsigned int i);
+		void setXMLAttrFloat(std::string_view path, std::string_view name, float f);
+		void setXMLAttrDouble(std::string_view path, std::string_view name, double d);
+		void setXMLAttrString(std::string_view path, std::string_view name, std::string_view s);
 	
 		/// adds a child element at a specific index in a list of same elements (0 for first),
 		/// adds to end if index is invalid
@@ -173,7 +488,7 @@ class XMLObject {
 		/// element aka "sub/element/test" or "/sub/1/element/2/test"
 		/// if an index is given for the final element in the path along with an index argument, the greater of
 		/// the two is used
-		XMLElement* addXMLChild(std::string path, int index=0);
+		XMLElement* addXMLChild(std::string_view path, int index=0);
 	
 		/// finds child element at specific index in a list of same elements (0 for first),
 		/// creates and adds to end if not found
@@ -181,10 +496,10 @@ class XMLObject {
 		/// element aka "sub/element/test" or "/sub/1/element/2/test"
 		/// if an index is given for the final element in the path along with an index argument, the greater of
 		/// the two is used
-		XMLElement* obtainXMLChild(std::string path, int index=0);
+		XMLElement* obtainXMLChild(std::string_view path, int index=0);
 
 		/// adds a comment as a child of the given element, creates elements not found in the path
-		void addXMLComment(std::string path, std::string comment);
+		void addXMLComment(std::string_view path, std::string_view comment);
 
 	/// \section Util
 
@@ -194,7 +509,7 @@ class XMLObject {
 
 		/// get/set this objects xml element name
 		inline std::string& getXMLName() {return m_elementName;}
-		inline void setXMLName(std::string name) {m_elementName = name;}
+		inline void setXMLName(std::string name) {m_elementName = name; changedXMLStructure();}
 	
 		/// is the XML document for this object currently loaded
 		/// returns true if this object is currently loaded or saving
@@ -227,28 +542,237 @@ class XMLObject {
 		/// param e is the root element of this object aka <getXmlName()> ...
 		virtual bool writeXML(XMLElement *e) {return false;}
 
+		/// callback to reset values when the object is released to an
+		/// XMLObjectFactory pool, called before the object is reused
+		virtual void resetXML() {}
+
+		/// size of the most derived object, override with sizeof(*this) in
+		/// every class which is moved so subscriptions to members are
+		/// re-pointed, default: 0, moving an object with subscriptions aborts
+		virtual size_t getXMLObjectSize() const {return 0;}
+
 	private:
 
 		/// subscribed attribute to load/save
 		struct _Attribute {
-			std::string name; ///< attribute name
+			std::pmr::string name; ///< attribute name
 			XMLType type; ///< attribute type
 			void *var; ///< pointer to subscribed variable
 			bool readOnly; ///< should this value be written when saving?
+			_Attribute(std::pmr::memory_resource *resource) : name(resource) {}
 		};
 	
 		/// subscribed element to load/save
 		struct _Element {
-			std::string path; ///< element path (or name)
+			std::pmr::string path; ///< element path (or name)
 			XMLType type; ///< element text type
 			void *var; ///< pointer to subscribed variable
 			bool readOnly; ///< should this value be written when saving?
-			std::vector<_Attribute*> attributes; ///< subscribed attributes
+			std::pmr::vector<_Attribute*> attributes; ///< subscribed attributes
+			XMLAttrIndex attributeIndex; ///< attribute names, numbered like attributes
+			_Element(std::pmr::memory_resource *resource) :
+				path(resource), attributes(resource), attributeIndex(resource) {}
 		};
 
+		/// subscribed list of repeated elements to load/save
+		struct _List {
+			std::string path; ///< parent element path, empty for this object's element
+			std::string name; ///< repeated element name
+			bool readOnly; ///< should this list be written when saving?
+
+			virtual ~_List() {}
+
+			/// number of entries
+			virtual size_t size() const = 0;
+
+			/// reserve space for entries
+			virtual void reserve(size_t size) = 0;
+
+			/// resize, keeps existing entries
+			virtual void resize(size_t size) = 0;
+
+			/// load/save the entry at index i from/to an element
+			virtual void load(size_t i, XMLElement *e) = 0;
+			virtual void save(size_t i, XMLElement *e) = 0;
+
+			/// re-point the vector pointer if it is in [begin, end)
+			virtual void repoint(uintptr_t begin, uintptr_t end, ptrdiff_t offset) = 0;
+		};
+
+		/// subscribed list of values
+		template<class T> struct _ValueList : public _List {
+			std::vector<T> *list; ///< subscribed vector
+			_ValueList(std::vector<T> *list) : list(list) {}
+			size_t size() const {return list->size();}
+			void reserve(size_t size) {list->reserve(size);}
+			void resize(size_t size) {list->resize(size);}
+			void load(size_t i, XMLElement *e) {
+				if constexpr(std::is_same<T, bool>::value) { // packed vector<bool>
+					bool value = false;
+					XML::getText(e, XML_TYPE_BOOL, &value);
+					(*list)[i] = value;
+				}
+				else {
+					XML::getText(e, XMLTypeOf<T>::type, &(*list)[i]);
+				}
+			}
+			void save(size_t i, XMLElement *e) {
+				if constexpr(std::is_same<T, bool>::value) { // packed vector<bool>
+					bool value = (*list)[i];
+					XML::setText(e, XML_TYPE_BOOL, &value);
+				}
+				else {
+					XML::setText(e, XMLTypeOf<T>::type, &(*list)[i]);
+				}
+			}
+			void repoint(uintptr_t begin, uintptr_t end, ptrdiff_t offset) {
+				repointXML(list, begin, end, offset);
+			}
+		};
+
+		/// subscribed list of objects
+		template<class T> struct _ObjectList : public _List {
+			std::vector<std::unique_ptr<T>> *list; ///< subscribed vector
+			_ObjectList(std::vector<std::unique_ptr<T>> *list) : list(list) {}
+			size_t size() const {return list->size();}
+			void reserve(size_t size) {list->reserve(size);}
+			void resize(size_t size) {
+				size_t old = list->size();
+				list->resize(size);
+				for(size_t i = old; i < size; ++i) {
+					(*list)[i].reset(new T);
+				}
+			}
+			void load(size_t i, XMLElement *e) {(*list)[i]->loadXML(e);}
+			void save(size_t i, XMLElement *e) {(*list)[i]->saveXML(e);}
+			void repoint(uintptr_t begin, uintptr_t end, ptrdiff_t offset) {
+				repointXML(list, begin, end, offset);
+			}
+		};
+
+		/// does T itself override getXMLObjectSize()? the member pointer is
+		/// taken through a derived class as the override is usually protected
+		template<class T> struct _HasObjectSize : public T {
+			static constexpr bool check() {
+				return std::is_same<decltype(&_HasObjectSize::getXMLObjectSize), size_t (T::*)() const>::value;
+			}
+		};
+
+		/// subscribed list of objects stored in place
+		template<class T> struct _InPlaceList : public _List {
+			std::vector<T> *list; ///< subscribed vector
+			_InPlaceList(std::vector<T> *list) : list(list) {}
+			size_t size() const {return list->size();}
+			void reserve(size_t size) {list->reserve(size);}
+			void resize(size_t size) {list->resize(size);}
+			void load(size_t i, XMLElement *e) {(*list)[i].loadXML(e);}
+			void save(size_t i, XMLElement *e) {(*list)[i].saveXML(e);}
+			void repoint(uintptr_t begin, uintptr_t end, ptrdiff_t offset) {
+				repointXML(list, begin, end, offset);
+			}
+		};
+
+		/// re-point a pointer into [begin, end) by offset, ie. a member of a
+		/// moved object to the same member of the new object
+		template<class T> static void repointXML(T *&p, uintptr_t begin, uintptr_t end, ptrdiff_t offset) {
+			uintptr_t address = (uintptr_t) p;
+			if(address >= begin && address < end) {
+				p = (T*)(address + offset);
+			}
+		}
+
+		/// take over everything from an object, this object must be empty
+		void moveXML(XMLObject &from);
+
+		friend class XMLObjectFactory;
+
+		/// subscribed factory
+		struct _Factory {
+			std::string path; ///< parent element path, empty for this object's element
+			XMLObjectFactory *factory; ///< creates & recycles the objects
+			std::vector<XMLObject*> *objects; ///< subscribed vector
+			bool readOnly; ///< should the objects be written when saving?
+		};
+
+		/// load/save subscribed factory objects
+		void loadXMLFactories(XMLElement *e);
+		void saveXMLFactories(XMLElement *e);
+
+		/// returns e or the next sibling element registered in a factory,
+		/// NULL if there are none
+		static XMLElement* nextXMLFactoryChild(XMLObjectFactory *factory, XMLElement *e);
+
+		/// add a list subscription, takes ownership of list,
+		/// returns true on success
+		bool addList(_List *list, std::string_view path, std::string_view name, bool readOnly);
+
+		/// load/save the binding table values, decodes into values if it is not NULL
+		void loadXMLBindings(XMLElement *e, XMLBoundValues *values);
+		void saveXMLBindings(XMLElement *e);
+
+		/// load the subscribed attributes of an element in a single walk over
+		/// its attributes, decodes into values if it is not NULL
+		void loadXMLAttributes(XMLElement *e, const _Element *elem, XMLBoundValues *values);
+
+		/// rebuild the attribute name index of a subscribed element
+		static void indexXMLAttributes(_Element *elem);
+
+		/// load/save subscribed lists & factory objects
+		void loadXMLLists(XMLElement *e);
+		void saveXMLLists(XMLElement *e);
+
+		/// create/destroy an _Element or _Attribute node from the resource of
+		/// the element vector
+		template<class T> T* newXMLNode() {
+			std::pmr::memory_resource *resource = m_elements.get_allocator().resource();
+			return new(resource->allocate(sizeof(T), alignof(T))) T(resource);
+		}
+		template<class T> void deleteXMLNode(T *node) {
+			node->~T();
+			m_elements.get_allocator().resource()->deallocate(node, sizeof(T), alignof(T));
+		}
+
+		/// cached converted value of an element text or attribute
+		struct _CachedValue {
+			std::pmr::string path; ///< element path
+			std::pmr::string name; ///< attribute name, empty for the element text
+			XMLType type; ///< value type, XML_TYPE_STRING_VIEW for strings
+			XMLElement *element; ///< element found at the path, NULL if none
+			XMLStatus status; ///< read status
+			union {
+				bool b;
+				int i;
+				unsigned int u;
+				float f;
+				double d;
+				const char *s; ///< points into the document
+			} value; ///< converted value
+			_CachedValue(std::pmr::memory_resource *resource) : path(resource), name(resource) {}
+		};
+
+		/// get a value from the cache, reads & adds it on first access,
+		/// T is bool, int, unsigned int, float, double or const char*
+		template<class T> XMLResult<T> getXMLCachedValue(std::string_view path, std::string_view name, XMLType type);
+
+		/// remove the cached values of an element text or attribute & all
+		/// values whose element was not found as it may have been created
+		void changedXMLValue(XMLElement *e, std::string_view name);
+
+		/// set the element of this object, clears the value cache
+		inline void resetXMLElement(XMLElement *e) {
+			m_element = e;
+			if(!m_valueCache.empty()) {
+				clearXMLValueCache();
+			}
+		}
+
+		/// create/destroy the document from m_resource or the default resource
+		void newXMLDocument();
+		void deleteXMLDocument();
+
 		/// find an element in the list by its path, returns NULL if not found
-		_Element* findElement(std::string path) {
-			std::vector<_Element*>::iterator iter;
+		_Element* findElement(std::string_view path) {
+			std::pmr::vector<_Element*>::iterator iter;
 			for(iter = m_elements.begin(); iter != m_elements.end(); ++iter) {
 				if((*iter)->path == path) {
 					return (*iter);
@@ -257,14 +781,105 @@ class XMLObject {
 			return NULL;
 		}
 
+		/// copy a loaded or saved string view into the string arena, if one is set
+		inline void internView(void *var) {
+			if(m_stringArena != NULL) {
+				std::string_view *view = (std::string_view*) var;
+				(*view) = m_stringArena->intern(*view);
+			}
+		}
+
+		/// compiled load/save plan step
+		struct _Step {
+
+			/// step operation
+			enum Op {
+				ENTER,   ///< find an attached object's element & enter it
+				DEFER,   ///< find a lazy object's element & record it
+				ELEMENT, ///< find the element for the following values
+				TEXT,    ///< load/save element text
+				ATTR,    ///< load/save an attribute
+				LISTS,   ///< load/save an object's lists, ends its values
+				LEAVE    ///< run an object's callback
+			};
+
+			Op op; ///< operation
+			XMLObject *object; ///< object the step belongs to
+			unsigned int depth; ///< element slot to start from
+			std::string name; ///< object element name, element path or attribute name
+			int index; ///< object element index
+			XMLType type; ///< value type
+			void *var; ///< value variable
+			bool readOnly; ///< skip when saving?
+			size_t end; ///< step to continue at if an element is not found
+			const _Element *element; ///< subscribed element for ELEMENT, its ATTR steps are loaded at once
+
+			_Step(Op op, XMLObject *object, unsigned int depth, std::string_view name="") :
+				op(op), object(object), depth(depth), name(name), index(0),
+				type(XML_TYPE_UNDEF), var(NULL), readOnly(false), end(0), element(NULL) {}
+		};
+
+		/// compile this object & attached objects if the plan is out of date
+		void updateXMLPlan();
+
+		/// add the steps for this object's values & attached objects,
+		/// this object's element is in slot depth
+		void addXMLPlanSteps(std::vector<_Step> &plan, unsigned int depth, unsigned int &maxDepth,
+		                     std::vector<std::pair<XMLObject*, unsigned long>> &objects);
+
+		/// run the compiled plan from this object's element
+		void runXMLLoadPlan(XMLElement *e);
+		void runXMLSavePlan(XMLElement *e);
+
+		/// invalidate compiled plans including this object, called when
+		/// attached objects or subscriptions change
+		inline void changedXMLStructure() {++m_structureVersion;}
+
+		/// load from an xml element, decodes subscribed values into the given
+		/// set instead of the subscribed variables if it is not NULL
+		bool loadXML(XMLElement *e, XMLBoundValues *values);
+
+		/// add profile table rows for this object & attached objects
+		void addXMLProfileRows(std::ostream &stream, unsigned int depth);
+
+		/// cancel pending lazy loads for this object & attached objects,
+		/// called when the document the recorded elements belong to is closed
+		void cancelXMLLoad();
+
 		bool m_docLoaded; ///< is the doc loaded?
 		std::string m_filename; ///< current filename
 		XMLDocument *m_xmlDoc; ///< xml document, NULL when not loaded
+		std::pmr::memory_resource *m_docResource; ///< resource the document was allocated from
 		XMLElement *m_element; ///< element for this object, NULL when not loaded
+		bool m_lazyLoad; ///< defer loading until ensureXMLLoaded()?
+		bool m_loadPending; ///< has m_element been recorded but not loaded yet?
+		bool m_snapshotEnabled; ///< publish a snapshot on every file load?
+		XMLPublished<XMLSnapshot> m_snapshot; ///< current snapshot
+		bool m_bufferedLoad; ///< decode into bound value sets?
+		unsigned long m_valuesSequence; ///< last bound values sequence number
+		XMLPublished<XMLBoundValues> m_values; ///< current bound values
+		std::shared_ptr<const XMLBoundValues> m_appliedValues; ///< last applied bound values
+		XMLStringArena *m_stringArena; ///< string view copies, not owned
+
+		XMLProfile m_profile; ///< profiling counters, kept without profiling so the layout does not change
 
 		std::string m_elementName; ///< name of the root element
-		std::vector<_Element *> m_elements; ///< attached elements/attributes
+		std::pmr::memory_resource *m_resource; ///< resource set in the constructor, not owned
+		std::pmr::vector<_Element *> m_elements; ///< attached elements/attributes
+		std::vector<_List *> m_lists; ///< subscribed lists
+		std::vector<_Factory *> m_factories; ///< subscribed factories
+		const XMLBindings *m_bindings; ///< per-class bindings, not owned
+
+		bool m_planEnabled; ///< load & save via the compiled plan?
+		std::vector<_Step> m_plan; ///< compiled plan
+		std::vector<XMLElement*> m_planElements; ///< element slots while running the plan
+		std::vector<std::pair<XMLObject*, unsigned long>> m_planObjects; ///< compiled objects & their structure versions
+		unsigned long m_structureVersion; ///< increased when objects or subscriptions change
 		std::vector<XMLObject *> m_objects; ///< attached xml objects to process
+		XMLObject *m_parent; ///< object this one is attached to, NULL if none
+
+		bool m_valueCacheEnabled; ///< cache values read via the data access functions?
+		std::pmr::unordered_multimap<size_t, _CachedValue> m_valueCache; ///< cached values by path & name hash
 };
 
 } // namespace
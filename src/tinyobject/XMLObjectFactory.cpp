@@ -0,0 +1,130 @@
+/*==============================================================================
+
+	XMLObjectFactory.cpp
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#include "XMLObjectFactory.h"
+
+#include <algorithm>
+#include "Log.h"
+#include "XMLObject.h"
+
+namespace tinyxml2 {
+
+XMLObjectFactory::~XMLObjectFactory() {
+	for(unsigned int i = 0; i < m_types.size(); ++i) {
+		for(unsigned int j = 0; j < m_types[i]->objects.size(); ++j) {
+			delete m_types[i]->objects[j];
+		}
+		delete m_types[i];
+	}
+}
+
+bool XMLObjectFactory::addType(std::string_view name, XMLObject* (*create)()) {
+	if(name == "" || create == NULL) {
+		LOG_WARN << "XMLObjectFactory: cannot add type \"" << name
+		         << "\", name is empty and/or create function is NULL" << std::endl;
+		return false;
+	}
+	if(findType(name) != NULL) {
+		LOG_WARN << "XMLObjectFactory: type \"" << name << "\" already added" << std::endl;
+		return false;
+	}
+	_Type *type = new _Type;
+	type->name = name;
+	type->create = create;
+	m_types.push_back(type);
+	return true;
+}
+
+bool XMLObjectFactory::hasType(std::string_view name) const {
+	return findType(name) != NULL;
+}
+
+XMLObject* XMLObjectFactory::obtain(std::string_view name) {
+	_Type *type = findType(name);
+	if(type == NULL) {
+		return NULL;
+	}
+	if(!type->pool.empty()) {
+		XMLObject *object = type->pool.back();
+		type->pool.pop_back();
+		return object;
+	}
+	XMLObject *object = type->create();
+	if(object->getXMLName() != type->name) {
+		object->setXMLName(type->name);
+	}
+	type->objects.push_back(object);
+	m_numCreated++;
+	return object;
+}
+
+void XMLObjectFactory::release(XMLObject *object) {
+	if(object == NULL) {
+		return;
+	}
+	_Type *type = findType(object->getXMLName());
+	if(type == NULL) {
+		LOG_WARN << "XMLObjectFactory: cannot release \"" << object->getXMLName()
+		         << "\" object, type not found" << std::endl;
+		return;
+	}
+	object->resetXMLElement(NULL);
+	object->m_loadPending = false;
+	object->resetXML();
+	type->pool.push_back(object);
+}
+
+unsigned int XMLObjectFactory::getNumPooled() const {
+	unsigned int num = 0;
+	for(unsigned int i = 0; i < m_types.size(); ++i) {
+		num += m_types[i]->pool.size();
+	}
+	return num;
+}
+
+void XMLObjectFactory::clearPool() {
+	for(unsigned int i = 0; i < m_types.size(); ++i) {
+		_Type *type = m_types[i];
+		std::sort(type->pool.begin(), type->pool.end());
+		type->objects.erase(std::remove_if(type->objects.begin(), type->objects.end(),
+			[type](XMLObject *object) {
+				return std::binary_search(type->pool.begin(), type->pool.end(), object);
+			}), type->objects.end());
+		for(unsigned int j = 0; j < type->pool.size(); ++j) {
+			delete type->pool[j];
+		}
+		type->pool.clear();
+	}
+}
+
+// PRIVATE
+
+XMLObjectFactory::_Type* XMLObjectFactory::findType(std::string_view name) const {
+	for(unsigned int i = 0; i < m_types.size(); ++i) {
+		if(m_types[i]->name == name) {
+			return m_types[i];
+		}
+	}
+	return NULL;
+}
+
+} // namespace
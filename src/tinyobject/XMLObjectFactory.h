@@ -0,0 +1,109 @@
+/*==============================================================================
+
+	XMLObjectFactory.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace tinyxml2 {
+
+class XMLObject;
+
+/// \class XMLObjectFactory
+/// \brief creates XMLObjects by element name & recycles them via a pool
+///
+/// register an XMLObject subclass per element name, then subscribe the factory
+/// with XMLObject::subscribeXMLFactory() to create an object for each
+/// registered child element when loading
+///
+/// released objects are reset via their resetXML() callback & kept in a pool
+/// for the next obtain() instead of being destroyed, so their subscriptions
+/// are only set up once
+///
+/// the factory owns all objects it creates & deletes them when it is
+/// destroyed, so it must outlive the objects it is subscribed to
+///
+class XMLObjectFactory {
+
+	public:
+
+		XMLObjectFactory() {}
+		virtual ~XMLObjectFactory();
+
+		XMLObjectFactory(const XMLObjectFactory &from) = delete;
+		XMLObjectFactory& operator=(const XMLObjectFactory &from) = delete;
+
+		/// register T for an element name, T is an XMLObject subclass with a
+		/// default constructor, returns false if the name is already registered
+		template<class T> bool addType(std::string_view name) {
+			static_assert(std::is_base_of<XMLObject, T>::value, "factory objects must be XMLObject subclasses");
+			return addType(name, &createObject<T>);
+		}
+
+		/// register a create function for an element name,
+		/// returns false if the name is already registered
+		bool addType(std::string_view name, XMLObject* (*create)());
+
+		/// is an element name registered?
+		bool hasType(std::string_view name) const;
+
+		/// get an object for an element name, recycled from the pool if
+		/// possible, the object's element name is set to name,
+		/// returns NULL if the name is not registered
+		XMLObject* obtain(std::string_view name);
+
+		/// reset an object via resetXML() & return it to the pool,
+		/// the object must have been obtained from this factory & must not
+		/// be released twice
+		void release(XMLObject *object);
+
+		/// number of objects created & number of objects in the pool
+		inline unsigned int getNumCreated() const {return m_numCreated;}
+		unsigned int getNumPooled() const;
+
+		/// delete the pooled objects
+		void clearPool();
+
+	private:
+
+		/// registered element name
+		struct _Type {
+			std::string name; ///< element name
+			XMLObject* (*create)(); ///< create function
+			std::vector<XMLObject*> objects; ///< all objects created
+			std::vector<XMLObject*> pool; ///< released objects
+		};
+
+		/// find a type by element name, returns NULL if not found
+		_Type* findType(std::string_view name) const;
+
+		/// create function for a type
+		template<class T> static XMLObject* createObject() {return new T;}
+
+		std::vector<_Type*> m_types; ///< registered types
+		unsigned int m_numCreated = 0; ///< number of objects created
+};
+
+} // namespace
@@ -0,0 +1,144 @@
+/*==============================================================================
+
+	XMLPath.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include <stddef.h>
+
+namespace tinyxml2 {
+
+/// element name & index of a path split at compile time
+struct XMLPathNode {
+	const char *name = NULL; ///< NUL-terminated element name
+	int index = 0; ///< index if in a list, 0 for first element
+};
+
+/// log an invalid path literal error, defined in XML.cpp
+void XMLPathLiteralError(const char *path, const char *reason);
+
+/// path split at compile time, use XML_PATH("foo/1/bar") to create one
+///
+/// holds the element names NUL-terminated & the nodes pointing at them, so it
+/// can not be copied, XML_PATH returns a reference to a static instance
+template<size_t N> class XMLPathLiteral {
+
+	public:
+
+		/// split a path literal, same syntax as XML::parsePath but an index
+		/// before an element name or an index which is not a positive number
+		/// is an error & does not compile when used via XML_PATH
+		constexpr XMLPathLiteral(const char (&path)[N]) : m_names(), m_nodes(), m_size(0) {
+			size_t i = 0;
+			while(i < N-1) {
+				size_t end = i;
+				while(end < N-1 && path[end] != '/') {
+					m_names[end] = path[end];
+					++end;
+				}
+				m_names[end] = '\0'; // replaces the slash
+				if(end > i) {
+					if(path[i] >= '0' && path[i] <= '9') { // index
+						if(m_size == 0 || m_hasIndex) {
+							invalid(path, "index without a preceding element name");
+							return;
+						}
+						int index = 0;
+						for(size_t j = i; j < end; ++j) {
+							if(path[j] < '0' || path[j] > '9') {
+								invalid(path, "index is not a number");
+								return;
+							}
+							index = index*10 + (path[j] - '0');
+						}
+						m_nodes[m_size-1].index = index;
+						m_hasIndex = true;
+					}
+					else { // element name
+						m_nodes[m_size].name = m_names + i;
+						++m_size;
+						m_hasIndex = false;
+					}
+				}
+				i = end+1;
+			}
+		}
+
+		XMLPathLiteral(const XMLPathLiteral &from) = delete;
+		XMLPathLiteral& operator=(const XMLPathLiteral &from) = delete;
+
+		/// get the nodes
+		constexpr const XMLPathNode* nodes() const {return m_nodes;}
+
+		/// number of nodes
+		constexpr size_t size() const {return m_size;}
+
+	private:
+
+		/// not constexpr so an invalid literal does not compile,
+		/// at runtime logs an error & the path is treated as empty
+		void invalid(const char *path, const char *reason) {
+			XMLPathLiteralError(path, reason);
+			m_size = 0;
+		}
+
+		char m_names[N]; ///< element names, NUL-terminated
+		XMLPathNode m_nodes[N/2+1]; ///< split nodes
+		size_t m_size; ///< number of nodes
+		bool m_hasIndex = false; ///< did the last node get an index?
+};
+
+/// \class XMLPath
+/// \brief a view of the nodes of a path split at compile time
+///
+/// accepted by XML::getChild & friends instead of a path string, no parsing
+/// or allocation happens at runtime, ie.
+///
+///     XML::getChild(root, XML_PATH("subelement/test/number"));
+///
+class XMLPath {
+
+	public:
+
+		template<size_t N> constexpr XMLPath(const XMLPathLiteral<N> &path) :
+			m_nodes(path.nodes()), m_size(path.size()) {}
+
+		/// get the nodes
+		constexpr const XMLPathNode* nodes() const {return m_nodes;}
+
+		/// number of nodes
+		constexpr size_t size() const {return m_size;}
+
+	private:
+
+		const XMLPathNode *m_nodes; ///< split nodes
+		size_t m_size; ///< number of nodes
+};
+
+} // namespace
+
+/// split a path string literal at compile time into a static XMLPathLiteral,
+/// malformed paths such as "1/foo" do not compile
+#define XML_PATH(path) \
+	([]() -> const tinyxml2::XMLPathLiteral<sizeof(path)>& { \
+		static constexpr tinyxml2::XMLPathLiteral<sizeof(path)> literal(path); \
+		return literal; \
+	}())
@@ -0,0 +1,115 @@
+/*==============================================================================
+
+	XMLPublished.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace tinyxml2 {
+
+/// \class XMLPublished
+/// \brief a shared pointer published by one thread & read by many others
+///
+/// reads never lock: a read registers in one of two reader counts, copies the
+/// current pointer & unregisters again, which is a fixed number of atomic
+/// operations no matter what the other threads do (wait-free)
+///
+/// publishing swaps in the new pointer & then waits for the reads which may
+/// still be copying the old one before dropping its reference, the reader
+/// count is flipped between the waits so new reads never hold it up,
+/// publishers are serialized with a mutex
+///
+/// the pointed-to object is released when the last reader drops its copy
+///
+template<class T> class XMLPublished {
+
+	public:
+
+		XMLPublished() : m_current(NULL), m_epoch(0) {
+			m_readers[0] = 0;
+			m_readers[1] = 0;
+		}
+
+		~XMLPublished() {
+			delete m_current.load();
+		}
+
+		XMLPublished(const XMLPublished &from) = delete;
+		XMLPublished& operator=(const XMLPublished &from) = delete;
+
+		/// get the current pointer, can be called from any thread
+		std::shared_ptr<const T> load() const {
+			unsigned int parity = m_epoch.load() & 1;
+			m_readers[parity].fetch_add(1);
+			const std::shared_ptr<const T> *current = m_current.load();
+			std::shared_ptr<const T> ret = (current ? *current : std::shared_ptr<const T>());
+			m_readers[parity].fetch_sub(1);
+			return ret;
+		}
+
+		/// publish a new pointer
+		void store(std::shared_ptr<const T> value) {
+			exchange(std::move(value));
+		}
+
+		/// publish a new pointer & return the previous one
+		std::shared_ptr<const T> exchange(std::shared_ptr<const T> value) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			const std::shared_ptr<const T> *next = NULL;
+			if(value) {
+				next = new std::shared_ptr<const T>(std::move(value));
+			}
+			const std::shared_ptr<const T> *previous = m_current.exchange(next);
+			synchronize();
+			std::shared_ptr<const T> ret;
+			if(previous != NULL) {
+				ret = *previous;
+				delete previous;
+			}
+			return ret;
+		}
+
+	private:
+
+		/// wait until all reads which started before the pointer was swapped
+		/// are done, both counts are waited for as a read may have picked
+		/// either parity, flipping first means only reads which were already
+		/// running are waited for
+		void synchronize() {
+			for(int i = 0; i < 2; ++i) {
+				unsigned int parity = m_epoch.fetch_add(1) & 1;
+				while(m_readers[parity].load() != 0) {
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		std::atomic<const std::shared_ptr<const T>*> m_current; ///< current pointer, NULL if empty
+		mutable std::atomic<unsigned int> m_readers[2]; ///< reads in progress per parity
+		std::atomic<unsigned int> m_epoch; ///< lowest bit is the parity for new reads
+		std::mutex m_mutex; ///< serializes publishers
+};
+
+} // namespace
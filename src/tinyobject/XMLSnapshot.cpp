@@ -0,0 +1,149 @@
+/*==============================================================================
+
+	XMLSnapshot.cpp
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#include "XMLSnapshot.h"
+
+#include "Log.h"
+
+namespace tinyxml2 {
+
+std::shared_ptr<const XMLSnapshot> XMLSnapshot::create(const XMLDocument *xmlDoc) {
+	if(xmlDoc == NULL) {
+		LOG_WARN << "XMLSnapshot: cannot create snapshot, document is NULL" << std::endl;
+		return std::shared_ptr<const XMLSnapshot>();
+	}
+	std::shared_ptr<XMLSnapshot> snapshot(new XMLSnapshot);
+	xmlDoc->DeepCopy(&snapshot->m_xmlDoc);
+	snapshot->freeze();
+	return snapshot;
+}
+
+std::shared_ptr<const XMLSnapshot> XMLSnapshot::load(std::string filename) {
+	std::shared_ptr<XMLSnapshot> snapshot(new XMLSnapshot);
+	if(snapshot->m_xmlDoc.LoadFile(filename.c_str()) != XML_SUCCESS) {
+		LOG_ERROR << "XMLSnapshot: could not load \"" << filename
+		          << "\": " << XML::getErrorString(&snapshot->m_xmlDoc) << std::endl;
+		return std::shared_ptr<const XMLSnapshot>();
+	}
+	snapshot->freeze();
+	return snapshot;
+}
+
+// DATA ACCESS
+
+bool XMLSnapshot::getXMLTextBool(std::string_view path, bool defaultVal) const {
+	return XML::getTextBool(getXMLChild(path), defaultVal);
+}
+
+int XMLSnapshot::getXMLTextInt(std::string_view path, int defaultVal) const {
+	return XML::getTextInt(getXMLChild(path), defaultVal);
+}
+
+unsigned int XMLSnapshot::getXMLTextUInt(std::string_view path, unsigned int defaultVal) const {
+	return XML::getTextUInt(getXMLChild(path), defaultVal);
+}
+
+float XMLSnapshot::getXMLTextFloat(std::string_view path, float defaultVal) const {
+	return XML::getTextFloat(getXMLChild(path), defaultVal);
+}
+
+double XMLSnapshot::getXMLTextDouble(std::string_view path, double defaultVal) const {
+	return XML::getTextDouble(getXMLChild(path), defaultVal);
+}
+
+std::string XMLSnapshot::getXMLTextString(std::string_view path, std::string_view defaultVal) const {
+	return XML::getTextString(getXMLChild(path), defaultVal);
+}
+
+std::string_view XMLSnapshot::getXMLTextView(std::string_view path, std::string_view defaultVal) const {
+	return XML::getTextView(getXMLChild(path), defaultVal);
+}
+
+bool XMLSnapshot::getXMLAttrBool(std::string_view path, std::string_view name, bool defaultVal) const {
+	return XML::getAttrBool(getXMLChild(path), name, defaultVal);
+}
+
+int XMLSnapshot::getXMLAttrInt(std::string_view path, std::string_view name, int defaultVal) const {
+	return XML::getAttrInt(getXMLChild(path), name, defaultVal);
+}
+
+unsigned int XMLSnapshot::getXMLAttrUInt(std::string_view path, std::string_view name, unsigned int defaultVal) const {
+	return XML::getAttrUInt(getXMLChild(path), name, defaultVal);
+}
+
+float XMLSnapshot::getXMLAttrFloat(std::string_view path, std::string_view name, float defaultVal) const {
+	return XML::getAttrFloat(getXMLChild(path), name, defaultVal);
+}
+
+double XMLSnapshot::getXMLAttrDouble(std::string_view path, std::string_view name, double defaultVal) const {
+	return XML::getAttrDouble(getXMLChild(path), name, defaultVal);
+}
+
+std::string XMLSnapshot::getXMLAttrString(std::string_view path, std::string_view name, std::string_view defaultVal) const {
+	return XML::getAttrString(getXMLChild(path), name, defaultVal);
+}
+
+std::string_view XMLSnapshot::getXMLAttrView(std::string_view path, std::string_view name, std::string_view defaultVal) const {
+	return XML::getAttrView(getXMLChild(path), name, defaultVal);
+}
+
+const XMLElement* XMLSnapshot::getXMLChild(std::string_view path, int index) const {
+	return XML::getChild(m_xmlDoc.RootElement(), path, index);
+}
+
+// PRIVATE
+
+// tinyxml2 unescapes names, values & text on first access and caches the
+// result in place, so touch every string once up front while still single
+// threaded
+void XMLSnapshot::freeze() {
+	const XMLNode *node = m_xmlDoc.FirstChild();
+	while(node != NULL) {
+		node->Value();
+		const XMLElement *element = node->ToElement();
+		if(element != NULL) {
+			const XMLAttribute *attr = element->FirstAttribute();
+			while(attr != NULL) {
+				attr->Name();
+				attr->Value();
+				attr = attr->Next();
+			}
+		}
+
+		// depth first: children, then siblings, then back up to the parent's sibling
+		if(node->FirstChild() != NULL) {
+			node = node->FirstChild();
+			continue;
+		}
+		while(node != NULL && node->NextSibling() == NULL) {
+			node = node->Parent();
+			if(node == &m_xmlDoc) {
+				node = NULL;
+			}
+		}
+		if(node != NULL) {
+			node = node->NextSibling();
+		}
+	}
+}
+
+} // namespace
@@ -0,0 +1,105 @@
+/*==============================================================================
+
+	XMLSnapshot.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include "XML.h"
+#include <memory>
+
+namespace tinyxml2 {
+
+/// \class XMLSnapshot
+/// \brief a frozen, read-only copy of an xml document
+///
+/// snapshots are created from a deep copy of a document and never change
+/// afterwards, so any number of threads can read from the same snapshot
+/// without locking while the original document is modified or reloaded
+///
+/// snapshots are handed out as shared pointers, the copy is released when the
+/// last reader drops its pointer, XMLObject publishes them with XMLPublished
+/// so getting the current snapshot does not lock either
+///
+class XMLSnapshot {
+
+	public:
+
+		/// create a snapshot from a deep copy of the given document,
+		/// returns an empty pointer if the document is NULL
+		static std::shared_ptr<const XMLSnapshot> create(const XMLDocument *xmlDoc);
+
+		/// create a snapshot by loading an xml file,
+		/// returns an empty pointer if the file could not be loaded
+		static std::shared_ptr<const XMLSnapshot> load(std::string filename);
+
+	/// \section Data Access
+	/// paths are relative to the root element of the snapshot document
+
+		/// element text access by type,
+		/// returns value on success or defaultVal if wrong type
+		bool getXMLTextBool(std::string_view path, bool defaultVal=false) const;
+		int getXMLTextInt(std::string_view path, int defaultVal=0) const;
+		unsigned int getXMLTextUInt(std::string_view path, unsigned int defaultVal=0) const;
+		float getXMLTextFloat(std::string_view path, float defaultVal=0.0f) const;
+		double getXMLTextDouble(std::string_view path, double defaultVal=0.0) const;
+		std::string getXMLTextString(std::string_view path, std::string_view defaultVal="") const;
+
+		/// element text as a view into the snapshot, valid as long as the snapshot
+		std::string_view getXMLTextView(std::string_view path, std::string_view defaultVal="") const;
+
+		/// element attribute access by type
+		/// returns value on success or defaultVal if attribute not found or wrong type
+		bool getXMLAttrBool(std::string_view path, std::string_view name, bool defaultVal=false) const;
+		int getXMLAttrInt(std::string_view path, std::string_view name, int defaultVal=0) const;
+		unsigned int getXMLAttrUInt(std::string_view path, std::string_view name, unsigned int defaultVal=0) const;
+		float getXMLAttrFloat(std::string_view path, std::string_view name, float defaultVal=0.0f) const;
+		double getXMLAttrDouble(std::string_view path, std::string_view name, double defaultVal=0.0) const;
+		std::string getXMLAttrString(std::string_view path, std::string_view name, std::string_view defaultVal="") const;
+
+		/// element attribute as a view into the snapshot, valid as long as the snapshot
+		std::string_view getXMLAttrView(std::string_view path, std::string_view name, std::string_view defaultVal="") const;
+
+		/// find child element by path and index (if in a list), returns NULL if element not found
+		const XMLElement* getXMLChild(std::string_view path, int index=0) const;
+
+	/// \section Util
+
+		/// get the snapshot document
+		inline const XMLDocument* getXMLDocument() const {return &m_xmlDoc;}
+
+		/// get the root element of the snapshot document,
+		/// returns NULL if the document is empty
+		inline const XMLElement* getXMLRootElement() const {return m_xmlDoc.RootElement();}
+
+	private:
+
+		XMLSnapshot() {}
+		XMLSnapshot(const XMLSnapshot &from);            // not defined, not copyable
+		XMLSnapshot& operator=(const XMLSnapshot &from); // not defined, not assignable
+
+		/// resolve all lazily processed node & attribute strings so that
+		/// concurrent reads never write into the document
+		void freeze();
+
+		XMLDocument m_xmlDoc; ///< frozen document copy
+};
+
+} // namespace
@@ -0,0 +1,70 @@
+/*==============================================================================
+
+	XMLStringArena.cpp
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#include "XMLStringArena.h"
+
+namespace tinyxml2 {
+
+XMLStringArena::XMLStringArena(size_t blockSize) :
+	m_blockSize(blockSize > 0 ? blockSize : 1),
+	m_next(NULL), m_available(0), m_bytes(0) {}
+
+std::string_view XMLStringArena::intern(std::string_view s) {
+	std::unordered_set<std::string_view>::const_iterator iter = m_strings.find(s);
+	if(iter != m_strings.end()) {
+		return *iter;
+	}
+
+	char *text;
+	size_t size = s.size() + 1;
+	if(size > m_blockSize) { // too long, gets a block of its own
+		m_blocks.emplace_back(new char[size]);
+		text = m_blocks.back().get();
+	}
+	else {
+		if(size > m_available) { // start a new block, the rest of the old one is wasted
+			m_blocks.emplace_back(new char[m_blockSize]);
+			m_next = m_blocks.back().get();
+			m_available = m_blockSize;
+		}
+		text = m_next;
+		m_next += size;
+		m_available -= size;
+	}
+	s.copy(text, s.size());
+	text[s.size()] = '\0';
+	m_bytes += size;
+
+	std::string_view view(text, s.size());
+	m_strings.insert(view);
+	return view;
+}
+
+void XMLStringArena::clear() {
+	m_strings.clear();
+	m_blocks.clear();
+	m_next = NULL;
+	m_available = 0;
+	m_bytes = 0;
+}
+
+} // namespace
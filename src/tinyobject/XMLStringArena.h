@@ -0,0 +1,77 @@
+/*==============================================================================
+
+	XMLStringArena.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace tinyxml2 {
+
+/// \class XMLStringArena
+/// \brief interned string storage for XML_TYPE_STRING_VIEW values
+///
+/// string views loaded with XML_TYPE_STRING_VIEW point into the text of the
+/// loaded document and are only valid until it is closed or reloaded, an
+/// XMLObject with an arena copies them here instead so they stay valid until
+/// the arena is cleared or destroyed
+///
+/// each distinct string is stored once, NUL-terminated, in large blocks, so
+/// loading repeated values like names or enum-like text allocates nothing
+/// once they have been seen
+///
+/// not thread safe, use one arena per loading thread
+///
+class XMLStringArena {
+
+	public:
+
+		/// strings are stored in blocks of blockSize bytes, longer strings
+		/// get a block of their own
+		XMLStringArena(size_t blockSize=4096);
+
+		/// get the interned copy of a string, adds it if it is new,
+		/// the returned view is NUL-terminated & valid until clear()
+		std::string_view intern(std::string_view s);
+
+		/// release all strings, invalidates all views returned by intern()
+		void clear();
+
+		/// number of distinct strings
+		inline size_t size() const {return m_strings.size();}
+
+		/// number of bytes used by strings, including the terminating '\0's
+		inline size_t getBytes() const {return m_bytes;}
+
+	private:
+
+		size_t m_blockSize; ///< default block size
+		std::vector<std::unique_ptr<char[]>> m_blocks; ///< string storage
+		char *m_next; ///< next free byte in the current block
+		size_t m_available; ///< free bytes in the current block
+		size_t m_bytes; ///< bytes used
+		std::unordered_set<std::string_view> m_strings; ///< views into the blocks
+};
+
+} // namespace
@@ -0,0 +1,233 @@
+/*==============================================================================
+
+	XMLTrace.cpp
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#include "XMLTrace.h"
+
+#include "Log.h"
+#include "Profile.h"
+
+#ifdef TINYOBJECT_PROFILE
+
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace tinyxml2 {
+
+// recorded span
+struct XMLTraceEvent {
+	const char *name;
+	std::string detail;
+	unsigned int thread;
+	double start; // us since trace start
+	double duration; // us
+};
+
+// recording state, s_start & s_events are guarded by s_mutex
+static std::atomic<bool> s_recording(false);
+static std::chrono::steady_clock::time_point s_start;
+static std::mutex s_mutex;
+static std::vector<XMLTraceEvent> s_events;
+
+// small sequential thread ids read better in trace viewers than hashes
+static unsigned int threadId() {
+	static std::atomic<unsigned int> next(1);
+	thread_local unsigned int id = next++;
+	return id;
+}
+
+// us since trace start
+static double micros(std::chrono::steady_clock::time_point time) {
+	return std::chrono::duration<double, std::micro>(time - s_start).count();
+}
+
+// escape a string for JSON
+static std::string escape(const std::string &s) {
+	std::string escaped;
+	escaped.reserve(s.size());
+	for(unsigned int i = 0; i < s.size(); ++i) {
+		char c = s[i];
+		switch(c) {
+			case '"':  escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if((unsigned char)c < 0x20) {
+					char hex[8];
+					snprintf(hex, sizeof(hex), "\\u%04x", c);
+					escaped += hex;
+				}
+				else {
+					escaped += c;
+				}
+				break;
+		}
+	}
+	return escaped;
+}
+
+// XML TRACE SPAN
+
+XMLTraceSpan::XMLTraceSpan(const char *name, const std::string &detail) :
+	m_name(NULL) {
+	if(s_recording.load(std::memory_order_relaxed)) {
+		m_name = name;
+		m_detail = detail;
+		m_start = std::chrono::steady_clock::now();
+	}
+}
+
+void XMLTraceSpan::end() {
+	if(m_name == NULL) {
+		return;
+	}
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	XMLTraceEvent event;
+	event.name = m_name;
+	event.detail = m_detail;
+	event.thread = threadId();
+	event.duration = std::chrono::duration<double, std::micro>(now - m_start).count();
+	m_name = NULL;
+	std::lock_guard<std::mutex> lock(s_mutex);
+	if(s_recording.load(std::memory_order_relaxed)) {
+		event.start = micros(m_start); // s_start is only read under the lock
+		s_events.push_back(event);
+	}
+}
+
+// FILES
+
+XMLError XMLTraceLoadFile(XMLDocument *doc, const char *filename) {
+	XMLTraceSpan readSpan("ReadFile", filename);
+	FILE *file = fopen(filename, "rb");
+	if(file == NULL) {
+		readSpan.end();
+		return doc->LoadFile(filename); // sets the document error
+	}
+	std::pmr::string text(XML::getMemoryResource());
+	long size = -1;
+	if(fseek(file, 0, SEEK_END) == 0) {
+		size = ftell(file);
+	}
+	if(size >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+		text.resize(size);
+		if(fread(text.data(), 1, size, file) != (size_t)size) {
+			size = -1;
+		}
+	}
+	fclose(file);
+	readSpan.end();
+	if(size < 0) {
+		return doc->LoadFile(filename); // sets the document error
+	}
+	XMLTraceSpan parseSpan("Parse", filename);
+	return doc->Parse(text.data(), text.size());
+}
+
+XMLError XMLTraceSaveFile(XMLDocument *doc, const char *filename) {
+	XMLTraceSpan printSpan("Print", filename);
+	XMLPrinter printer;
+	doc->Print(&printer);
+	printSpan.end();
+	XMLTraceSpan writeSpan("WriteFile", filename);
+	FILE *file = fopen(filename, "w");
+	if(file == NULL) {
+		writeSpan.end();
+		return doc->SaveFile(filename); // sets the document error
+	}
+	size_t size = printer.CStrSize() - 1; // without the '\0'
+	bool written = (fwrite(printer.CStr(), 1, size, file) == size);
+	written = (fclose(file) == 0) && written;
+	writeSpan.end();
+	if(!written) {
+		return doc->SaveFile(filename); // sets the document error
+	}
+	return XML_SUCCESS;
+}
+
+// XML TRACE
+
+bool XMLTrace::start() {
+	std::lock_guard<std::mutex> lock(s_mutex);
+	s_events.clear();
+	s_start = std::chrono::steady_clock::now();
+	s_recording.store(true);
+	return true;
+}
+
+bool XMLTrace::stop(std::string filename) {
+	std::vector<XMLTraceEvent> events;
+	{
+		std::lock_guard<std::mutex> lock(s_mutex);
+		s_recording.store(false);
+		events.swap(s_events);
+	}
+	std::ofstream file(filename.c_str());
+	if(!file.is_open()) {
+		LOG_ERROR << "XMLTrace: could not open \"" << filename << "\"" << std::endl;
+		return false;
+	}
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+	for(unsigned int i = 0; i < events.size(); ++i) {
+		const XMLTraceEvent &e = events[i];
+		file << "{\"name\":\"" << e.name;
+		if(!e.detail.empty()) {
+			file << " " << escape(e.detail);
+		}
+		file << "\",\"cat\":\"tinyobject\",\"ph\":\"X\",\"pid\":1"
+		     << ",\"tid\":" << e.thread
+		     << ",\"ts\":" << std::fixed << e.start
+		     << ",\"dur\":" << e.duration << "}"
+		     << (i+1 < events.size() ? "," : "") << std::endl;
+	}
+	file << "]}" << std::endl;
+	return file.good();
+}
+
+bool XMLTrace::isRecording() {
+	return s_recording.load();
+}
+
+} // namespace
+
+#else
+
+namespace tinyxml2 {
+
+bool XMLTrace::start() {
+	LOG_WARN << "XMLTrace: tracing not available, build with profiling enabled" << std::endl;
+	return false;
+}
+
+bool XMLTrace::stop(std::string) {
+	return false;
+}
+
+bool XMLTrace::isRecording() {
+	return false;
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,57 @@
+/*==============================================================================
+
+	XMLTrace.h
+	
+	tinyobject: object-based xml classes for TinyXml-2
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#pragma once
+
+#include <string>
+
+namespace tinyxml2 {
+
+/// \class XMLTrace
+/// \brief records XMLObject load/save spans as Chrome trace events
+///
+/// while recording, XMLObject file loads & saves, file reads & writes,
+/// parsing & printing, per object loadXML/saveXML and the readXML/writeXML
+/// callbacks are recorded as nested spans from all threads, stop() writes
+/// them as Chrome trace-event JSON which can be opened in chrome://tracing or
+/// https://ui.perfetto.dev
+///
+/// spans are only recorded when the library is built with TINYOBJECT_PROFILE
+/// defined (configure --enable-profile)
+///
+class XMLTrace {
+
+	public:
+
+		/// start recording, clears any previously recorded spans,
+		/// returns false if tracing is not compiled in
+		static bool start();
+
+		/// stop recording & write the recorded spans to a JSON file,
+		/// returns true on success
+		static bool stop(std::string filename);
+
+		/// returns true while recording
+		static bool isRecording();
+};
+
+} // namespace
@@ -22,5 +22,14 @@
 ==============================================================================*/
 #pragma once
 
+#include "LogSink.h"
 #include "XML.h"
+#include "XMLAlloc.h"
+#include "XMLBinding.h"
+#include "XMLBoundValues.h"
 #include "XMLObject.h"
+#include "XMLObjectFactory.h"
+#include "XMLPublished.h"
+#include "XMLSnapshot.h"
+#include "XMLStringArena.h"
+#include "XMLTrace.h"
@@ -0,0 +1,326 @@
+/*==============================================================================
+
+	main.cpp
+	
+	togen: synthetic test document generator for tinyobject
+  
+	Copyright (C) 2009, 2010 Dan Wilcox <danomatika@gmail.com>
+
+	This program is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+==============================================================================*/
+#include <errno.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+// writes documents matching the data/test.xml schema:
+//
+//     <xmltest>
+//         <argtest .../> & <elementtest>...</elementtest>
+//         <object> * objects, each with subobjects nested depth levels
+//         <objecttest> with list <object> entries
+//     </xmltest>
+//
+// output is streamed so document size is only limited by disk space and the
+// same options & seed always produce the same document
+
+// generator options
+struct Options {
+	unsigned long objects; ///< number of top level <object> elements
+	unsigned int depth; ///< <subobject> nesting depth per object
+	unsigned int attributes; ///< extra attributes per object & subobject
+	unsigned long list; ///< number of <object> elements in <objecttest>
+	unsigned int text; ///< text length for string values
+	unsigned long long size; ///< stop adding objects after this many bytes, 0 for no limit
+	uint64_t seed; ///< random seed
+	const char *output; ///< output filename, NULL for stdout
+
+	Options() : objects(1), depth(1), attributes(0), list(2), text(16),
+	            size(0), seed(1), output(NULL) {}
+};
+
+// deterministic random numbers, splitmix64:
+// http://xoshiro.di.unimi.it/splitmix64.c
+class Random {
+
+	public:
+
+		Random(uint64_t seed) : m_state(seed) {}
+
+		uint64_t next() {
+			uint64_t z = (m_state += 0x9e3779b97f4a7c15ULL);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			return z ^ (z >> 31);
+		}
+
+		/// float in [-range, range)
+		double real(double range) {
+			return ((next() >> 11) * (1.0 / 9007199254740992.0) * 2.0 - 1.0) * range;
+		}
+
+	private:
+
+		uint64_t m_state;
+};
+
+// buffered writer which tracks the number of bytes written & write errors
+class Writer {
+
+	public:
+
+		Writer(FILE *file) : m_file(file), m_written(0), m_failed(false) {}
+
+		void write(const char *s, size_t len) {
+			if(fwrite(s, 1, len, m_file) != len) {
+				m_failed = true;
+			}
+			m_written += len;
+		}
+
+		void write(const char *s) {write(s, strlen(s));}
+
+		void write(const std::string &s) {write(s.c_str(), s.size());}
+
+		void indent(unsigned int level) {
+			for(unsigned int i = 0; i < level; ++i) {
+				write("\t", 1);
+			}
+		}
+
+		/// <name>value</name> on its own line
+		void element(unsigned int level, const char *name, const char *value) {
+			indent(level);
+			printf("<%s>", name);
+			write(value);
+			printf("</%s>\n", name);
+		}
+
+		void printf(const char *format, ...) {
+			va_list args;
+			va_start(args, format);
+			int len = vfprintf(m_file, format, args);
+			va_end(args);
+			if(len > 0) {
+				m_written += len;
+			}
+			else if(len < 0) {
+				m_failed = true;
+			}
+		}
+
+		inline unsigned long long getWritten() {return m_written;}
+
+		/// did a write fail? ie. disk full or closed pipe
+		inline bool hasFailed() {return m_failed;}
+
+	private:
+
+		FILE *m_file;
+		unsigned long long m_written;
+		bool m_failed;
+};
+
+// random lowercase words separated by spaces, exactly len chars long
+static const std::string& text(Random &random, unsigned int len) {
+	static std::string s;
+	s.resize(len);
+	for(unsigned int i = 0; i < len; ++i) {
+		uint64_t r = random.next();
+		s[i] = ((r & 7) == 0 && i > 0 && i < len-1 && s[i-1] != ' ') ? ' ' : (char)('a' + (r >> 8) % 26);
+	}
+	return s;
+}
+
+// extra attributes a0="..." a1="..." ...
+static void attributes(Writer &w, Random &random, const Options &options) {
+	for(unsigned int i = 0; i < options.attributes; ++i) {
+		w.printf(" a%u=\"%.6g\"", i, random.real(1000));
+	}
+}
+
+// <subelement><test><text type="..">..</text><number>..</number></test></subelement>
+static void subelement(Writer &w, Random &random, const Options &options, unsigned int level) {
+	w.indent(level);   w.write("<subelement>\n");
+	w.indent(level+1); w.write("<test>\n");
+	w.indent(level+2); w.write("<text type=\"gen\">"); w.write(text(random, options.text)); w.write("</text>\n");
+	w.indent(level+2); w.printf("<number>%.6g</number>\n", random.real(10000));
+	w.indent(level+1); w.write("</test>\n");
+	w.indent(level);   w.write("</subelement>\n");
+}
+
+// <subobject> nested depth levels
+static void subobject(Writer &w, Random &random, const Options &options,
+                      unsigned int level, unsigned int depth, const std::string &name) {
+	if(depth == 0) {
+		return;
+	}
+	w.indent(level);
+	w.printf("<subobject name=\"%s\"", name.c_str());
+	attributes(w, random, options);
+	w.write(">\n");
+	w.indent(level+1); w.printf("<baz>%.6g</baz>\n", random.real(1000));
+	w.element(level+1, "ka", text(random, options.text).c_str());
+	subelement(w, random, options, level+1);
+	subobject(w, random, options, level+1, depth-1, name + "_");
+	w.indent(level);
+	w.write("</subobject>\n");
+}
+
+// <object> with nested subobjects
+static void object(Writer &w, Random &random, const Options &options,
+                   unsigned int level, unsigned int depth, unsigned long index) {
+	char name[32];
+	snprintf(name, sizeof(name), "object%lu", index);
+	w.indent(level);
+	w.printf("<object name=\"%s\"", name);
+	attributes(w, random, options);
+	w.write(">\n");
+	w.element(level+1, "foo", text(random, options.text).c_str());
+	w.indent(level+1); w.printf("<bar>%.6g</bar>\n", random.real(1000));
+	subobject(w, random, options, level+1, depth, std::string("sub") + name);
+	subelement(w, random, options, level+1);
+	w.indent(level);
+	w.write("</object>\n");
+}
+
+static void generate(Writer &w, const Options &options) {
+	Random random(options.seed);
+
+	w.write("<?xml version=\"1.0\" ?>\n");
+	w.write("<xmltest author=\"togen\">\n");
+
+	// argument & element text tests
+	w.printf("\t<argtest bool1=\"1\" bool0=\"0\" boolT=\"true\" boolF=\"false\" "
+	         "int=\"%d\" uint=\"%u\" float=\"%.6g\" double=\"%.9g\" string=\"%s\"/>\n",
+	         (int)(random.next() % 2001) - 1000, (unsigned int)(random.next() % 1000),
+	         random.real(100), random.real(1000), text(random, options.text).c_str());
+	w.write("\t<elementtest>\n");
+	w.write("\t\t<bool1>1</bool1>\n\t\t<bool0>0</bool0>\n\t\t<boolT>true</boolT>\n\t\t<boolF>false</boolF>\n");
+	w.printf("\t\t<int>%d</int>\n", (int)(random.next() % 2001) - 1000);
+	w.printf("\t\t<uint>%u</uint>\n", (unsigned int)(random.next() % 1000));
+	w.printf("\t\t<float>%.6g</float>\n", random.real(100));
+	w.printf("\t\t<double>%.9g</double>\n", random.real(1000));
+	w.element(2, "string", text(random, options.text).c_str());
+	w.write("\t</elementtest>\n");
+
+	// nested objects
+	for(unsigned long i = 0; i < options.objects; ++i) {
+		if(w.hasFailed() || (options.size > 0 && w.getWritten() >= options.size)) {
+			break;
+		}
+		object(w, random, options, 1, options.depth, i);
+	}
+
+	// object list
+	w.write("\t<objecttest>\n");
+	for(unsigned long i = 0; i < options.list && !w.hasFailed(); ++i) {
+		object(w, random, options, 2, 0, i);
+	}
+	w.write("\t</objecttest>\n");
+
+	w.write("</xmltest>\n");
+}
+
+static void usage() {
+	fprintf(stderr,
+		"usage: togen [options]\n"
+		"  -n, --objects N     number of <object> elements, default 1\n"
+		"  -d, --depth N       <subobject> nesting depth, default 1\n"
+		"  -a, --attributes N  extra attributes per object, default 0\n"
+		"  -l, --list N        <objecttest> list length, default 2\n"
+		"  -t, --text N        string value length, default 16\n"
+		"  -s, --size N[k|m|g] stop adding objects after N bytes, default no limit\n"
+		"  -r, --seed N        random seed, default 1\n"
+		"  -o, --output FILE   output file, default stdout\n");
+}
+
+// parse a number with an optional k, m, or g suffix
+static unsigned long long number(const char *s) {
+	char *end = NULL;
+	unsigned long long n = strtoull(s, &end, 10);
+	switch(end ? *end : 0) {
+		case 'k': case 'K': return n << 10;
+		case 'm': case 'M': return n << 20;
+		case 'g': case 'G': return n << 30;
+		default: return n;
+	}
+}
+
+int main(int argc, char *argv[]) {
+	Options options;
+	for(int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if(arg == "-h" || arg == "--help") {
+			usage();
+			return 0;
+		}
+		if(i+1 >= argc) {
+			usage();
+			return 1;
+		}
+		const char *value = argv[++i];
+		if(arg == "-n" || arg == "--objects")         {options.objects = number(value);}
+		else if(arg == "-d" || arg == "--depth")      {options.depth = number(value);}
+		else if(arg == "-a" || arg == "--attributes") {options.attributes = number(value);}
+		else if(arg == "-l" || arg == "--list")       {options.list = number(value);}
+		else if(arg == "-t" || arg == "--text")       {options.text = number(value);}
+		else if(arg == "-s" || arg == "--size")       {options.size = number(value);}
+		else if(arg == "-r" || arg == "--seed")       {options.seed = number(value);}
+		else if(arg == "-o" || arg == "--output")     {options.output = value;}
+		else {
+			fprintf(stderr, "togen: unknown option %s\n", arg.c_str());
+			usage();
+			return 1;
+		}
+	}
+
+	// a size limit without an object count means fill up to the size
+	if(options.size > 0 && options.objects == 1) {
+		options.objects = (unsigned long)-1;
+	}
+
+	FILE *file = stdout;
+	if(options.output) {
+		file = fopen(options.output, "wb");
+		if(!file) {
+			fprintf(stderr, "togen: could not open %s\n", options.output);
+			return 1;
+		}
+	}
+	static char buffer[1 << 16];
+	setvbuf(file, buffer, _IOFBF, sizeof(buffer));
+
+	Writer writer(file);
+	generate(writer, options);
+
+	// buffered data is only written on flush or close, so check those too
+	bool failed = writer.hasFailed();
+	if(file != stdout) {
+		failed = (fclose(file) != 0) || failed;
+	}
+	else {
+		failed = (fflush(file) != 0) || failed;
+	}
+	if(failed) {
+		fprintf(stderr, "togen: could not write %s: %s\n",
+		        options.output ? options.output : "stdout", strerror(errno));
+		return 1;
+	}
+	return 0;
+}
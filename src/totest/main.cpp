@@ -21,7 +21,9 @@
 
 ==============================================================================*/
 #include <tinyobject/tinyobject.h>
+#include <atomic>
 #include <iostream>
+#include <thread>
 
 using namespace std;
 using namespace tinyxml2;
@@ -35,13 +37,17 @@ class Object : public XMLObject {
 
 	public:
 
-		Object() : XMLObject("object") {}
+		// the name is subscribed, the other values are read within the callback
+		Object() : XMLObject("object") {
+			subscribeXMLAttribute("", "name", XML_TYPE_STRING, &name);
+		}
+
+		const string& getName() const {return name;}
 	
 	protected:
 	
 		// read all values within callback
 		bool readXML(tinyxml2::XMLElement *e) {
-			name = getXMLAttrString("", "name");
 			foo = getXMLTextString("foo");
 			bar = getXMLTextFloat("bar");
 			text = getXMLTextString("subelement/test/text");
@@ -62,6 +68,10 @@ class Object : public XMLObject {
 			setXMLTextFloat("bar", bar);
 			return true;
 		}
+
+		// objects are stored in place in vectors, so the subscription to the
+		// name member must be re-pointed when the object is moved
+		size_t getXMLObjectSize() const {return sizeof(*this);}
 	
 		string name;
 		string foo;
@@ -131,17 +141,18 @@ class Processor : public XMLObject {
 		// set the object's element name, in this case our root element name
 		Processor() : XMLObject("xmltest") {
 			
-			Object *object = new Object;
-			SubObject *subobject = new SubObject;
-			
 			// next subobject inside object
-			object->addXMLObject(subobject);
+			object.addXMLObject(&subobject);
 			
 			// nest object inside this class
-			addXMLObject(object);
+			addXMLObject(&object);
 			
 			// both objects will be called with the element of the same name
 			// automatically
+			
+			// load the repeated objects in objecttest into a list, Object
+			// instances are created as needed, read only so they aren't saved
+			subscribeXMLList("objecttest", "object", &objects, true);
 		}
 		
 	protected:
@@ -177,19 +188,10 @@ class Processor : public XMLObject {
 			     << "string: " << getXMLTextString("elementtest/string") << endl;
 			cout << "DONE" << endl << endl;
 			
-			// grab elements using XMLElement directly
-			XMLElement *child = getXMLChild("objecttest");
-			if(child) {
-				cout << "OBJECT TEST: " << getNumXMLChildren("objecttest") << endl;
-				// load object class manually
-				XMLElement *subchild = child->FirstChildElement();
-				while(subchild != NULL) {
-					Object o;
-					o.loadXML(subchild); // prints here when the class readXML function called
-					subchild = subchild->NextSiblingElement();
-				}
-				cout << "DONE" << endl << endl;
-			}
+			// objects were already loaded via the list subscription,
+			// their readXML functions print when called
+			cout << "OBJECT TEST: " << objects.size() << endl;
+			cout << "DONE" << endl << endl;
 			return true;
 		}
 	
@@ -212,8 +214,1003 @@ class Processor : public XMLObject {
 			
 			return true;
 		}
+		
+		// attached objects are members, they detach themselves when destroyed
+		Object object;
+		SubObject subobject;
+
+		vector<unique_ptr<Object>> objects;
+};
+
+// an xml object subclass using a binding table instead of subscriptions,
+// loads the argtest & elementtest values
+class BoundObject : public XMLObject {
+
+	public:
+
+		// set the class binding table in the constructor, values will be filled
+		// automatically when the XML data is loaded
+		BoundObject() : XMLObject("xmltest"), attrInt(0), textDouble(0) {
+			setXMLBindings(&bindings());
+		}
+
+		// member variable bindings declared once for all BoundObjects, this
+		// could also be done by subscribing variable references in the
+		// constructor, but then each object keeps its own copy of the paths
+		static const XMLBindings& bindings() {
+			static const XMLBindings table({
+
+				// bind attribute data
+				XMLBinding::attribute<&BoundObject::attrInt>("argtest", "int"),
+				XMLBinding::attribute<&BoundObject::attrString>("argtest", "string"),
+
+				// bind nested element text data
+				XMLBinding::element<&BoundObject::textDouble>("elementtest/double"),
+				XMLBinding::element<&BoundObject::textString>("elementtest/string")
+			});
+			return table;
+		}
+
+		int attrInt;
+		string attrString;
+
+		double textDouble;
+		string textString;
+};
+
+// load the bound values & make sure a table can't be set on an object of
+// another class, returns false on failure
+bool bindingTest(XMLElement *root) {
+	BoundObject object;
+	object.loadXML(root);
+	cout << "    argtest int: " << object.attrInt << endl
+	     << "    argtest string: " << object.attrString << endl
+	     << "    elementtest/double: " << object.textDouble << endl
+	     << "    elementtest/string: " << object.textString << endl;
+	if(object.attrInt != -100 || object.textString != "hello") {
+		cout << "    FAILED: bound values not loaded" << endl;
+		return false;
+	}
+
+	// the table binds BoundObject members, a SubObject has none of them
+	SubObject other;
+	if(other.setXMLBindings(&BoundObject::bindings())) {
+		cout << "    FAILED: set bindings of another class" << endl;
+		return false;
+	}
+	return true;
+}
+
+// a quiet xml object subclass for allocation checks, loads the argtest &
+// elementtest values via subscriptions without any callback output
+class AllocObject : public XMLObject {
+
+	public:
+
+		AllocObject() : XMLObject("xmltest") {
+			subscribeXMLAttribute("argtest", "int", XML_TYPE_INT, &attrInt);
+			subscribeXMLAttribute("argtest", "float", XML_TYPE_FLOAT, &attrFloat);
+			subscribeXMLAttribute("argtest", "string", XML_TYPE_STRING, &attrString);
+			subscribeXMLElement("elementtest/uint", XML_TYPE_UINT, &textUInt);
+			subscribeXMLElement("elementtest/double", XML_TYPE_DOUBLE, &textDouble);
+			subscribeXMLElement("elementtest/string", XML_TYPE_STRING, &textString);
+		}
+
+	protected:
+
+		int attrInt;
+		float attrFloat;
+		string attrString;
+
+		unsigned int textUInt;
+		double textDouble;
+		string textString;
+};
+
+// allocation budget for an entry point
+struct AllocBudget {
+	XMLAllocEntry entry;
+	uint64_t count; // max number of allocations
+};
+
+// check the allocations counted since the last reset against the budgets,
+// returns false if any entry point went over
+bool checkAllocBudgets(const char *what, const AllocBudget *budgets, int num) {
+	bool ret = true;
+	for(int i = 0; i < num; ++i) {
+		uint64_t count = XMLAlloc::getCount(budgets[i].entry);
+		cout << "    " << what << " " << XMLAlloc::getName(budgets[i].entry) << ": " << count
+		     << " (" << XMLAlloc::getBytes(budgets[i].entry) << " bytes)" << endl;
+		if(count > budgets[i].count) {
+			cout << "    FAILED: " << what << " " << XMLAlloc::getName(budgets[i].entry)
+			     << " allocated " << count << " times, budget is " << budgets[i].count << endl;
+			ret = false;
+		}
+	}
+	return ret;
+}
+
+// reload a warmed up object & check the allocations per entry point against
+// explicit budgets, returns false if a budget is exceeded
+bool allocTest(XMLElement *root) {
+	AllocObject object;
+	object.loadXML(root);
+
+	// reloading the same document reuses the string capacity of the first load
+	static const AllocBudget loadBudgets[] = {
+		{XML_ALLOC_LOAD_XML, 0},
+		{XML_ALLOC_GET_CHILD, 0},
+		{XML_ALLOC_PARSE_PATH, 0},
+		{XML_ALLOC_GET_VALUE, 0}
+	};
+	XMLAlloc::reset();
+	object.loadXML(root);
+	bool ret = checkAllocBudgets("loadXML", loadBudgets, sizeof(loadBudgets)/sizeof(AllocBudget));
+
+	// path & attribute lookups using literals should not allocate
+	static const AllocBudget lookupBudgets[] = {
+		{XML_ALLOC_GET_CHILD, 0},
+		{XML_ALLOC_GET_VALUE, 0}
+	};
+	XMLAlloc::reset();
+	int value = 0;
+	XML::getAttr(XML::getChild(root, "argtest"), "int", XML_TYPE_INT, &value);
+	XML::getTextView(XML::getChild(root, "elementtest/string"));
+	XML::getTextView(XML::getChild(root, XML_PATH("elementtest/string")));
+	if(!checkAllocBudgets("lookup", lookupBudgets, sizeof(lookupBudgets)/sizeof(AllocBudget))) {
+		ret = false;
+	}
+	return ret;
+}
+
+// objects stored in place in a vector
+class ObjectList : public XMLObject {
+
+	public:
+
+		ObjectList() : XMLObject("objecttest") {
+			subscribeXMLList("", "object", &objects, true);
+		}
+
+		vector<Object> objects;
+};
+
+// load & reload a list of objects stored in place which grows each time, the
+// vector reallocates & moves the already loaded objects, returns false if a
+// name was not loaded, the names shift each load so stale values are caught
+bool listTest() {
+	XMLDocument doc;
+	XMLElement *root = doc.NewElement("objecttest");
+	doc.InsertEndChild(root);
+	ObjectList list;
+	const char *names[] = {"one", "two", "three", "four", "five", "six"};
+	const int counts[] = {2, 5, 6};
+	bool ret = true;
+	for(int load = 0; load < 3; ++load) {
+		int count = counts[load];
+		root->DeleteChildren();
+		for(int i = 0; i < count; ++i) {
+			XMLElement *e = doc.NewElement("object");
+			e->SetAttribute("name", names[(i + load) % 6]);
+			root->InsertEndChild(e);
+		}
+		list.loadXML(root);
+		if(list.objects.size() != (size_t)count) {
+			cout << "    FAILED: " << list.objects.size() << " objects, expected " << count << endl;
+			return false;
+		}
+		for(int i = 0; i < count; ++i) {
+			if(list.objects[i].getName() != names[(i + load) % 6]) {
+				cout << "    FAILED: object " << i << " name \"" << list.objects[i].getName()
+				     << "\", expected \"" << names[(i + load) % 6] << "\"" << endl;
+				ret = false;
+			}
+		}
+	}
+	return ret;
+}
+
+// shapes created by a factory from their element names
+class Shape : public XMLObject {
+
+	public:
+
+		Shape(string name) : XMLObject(name), size(0) {
+			subscribeXMLAttribute("", "size", XML_TYPE_INT, &size);
+		}
+
+		int size;
+
+	protected:
+
+		// called when the factory takes the shape back into its pool
+		void resetXML() {size = 0;}
+};
+
+class Circle : public Shape {
+	public:
+		Circle() : Shape("circle") {}
+};
+
+class Square : public Shape {
+	public:
+		Square() : Shape("square") {}
 };
 
+// shapes created by a factory for each child element
+class Scene : public XMLObject {
+
+	public:
+
+		Scene(XMLObjectFactory *factory) : XMLObject("scene") {
+			subscribeXMLFactory("", factory, &shapes, true);
+		}
+
+		vector<XMLObject*> shapes; // owned by the factory
+};
+
+// load a scene whose shapes change between loads, objects are recycled by
+// the factory so going back to an earlier set of shapes creates no new ones,
+// returns false if a shape was not loaded or an object was created
+bool factoryTest() {
+	XMLObjectFactory factory;
+	factory.addType<Circle>("circle");
+	factory.addType<Square>("square");
+	XMLDocument doc;
+	XMLElement *root = doc.NewElement("scene");
+	doc.InsertEndChild(root);
+	Scene scene(&factory);
+	const char *shapes[][4] = {
+		{"circle", "square", "circle", NULL},
+		{"square", "square", "circle", "circle"},
+		{"circle", "square", "circle", NULL}
+	};
+	unsigned int created = 0;
+	for(int load = 0; load < 3; ++load) {
+		root->DeleteChildren();
+		int count = 0;
+		for(; count < 4 && shapes[load][count] != NULL; ++count) {
+			XMLElement *e = doc.NewElement(shapes[load][count]);
+			e->SetAttribute("size", count + 1);
+			root->InsertEndChild(e);
+		}
+		scene.loadXML(root);
+		cout << "    load " << load << ": " << scene.shapes.size() << " shapes, "
+		     << factory.getNumCreated() << " created, "
+		     << factory.getNumPooled() << " pooled" << endl;
+		if(scene.shapes.size() != (size_t)count) {
+			cout << "    FAILED: " << scene.shapes.size() << " shapes, expected " << count << endl;
+			return false;
+		}
+		for(int i = 0; i < count; ++i) {
+			Shape *shape = (Shape*)scene.shapes[i];
+			if(shape->getXMLName() != shapes[load][i] || shape->size != i + 1) {
+				cout << "    FAILED: shape " << i << " is " << shape->getXMLName()
+				     << " size " << shape->size << ", expected " << shapes[load][i]
+				     << " size " << i + 1 << endl;
+				return false;
+			}
+		}
+		if(load == 2 && factory.getNumCreated() != created) {
+			cout << "    FAILED: reload created " << factory.getNumCreated() - created
+			     << " objects" << endl;
+			return false;
+		}
+		created = factory.getNumCreated();
+	}
+	return true;
+}
+
+// an attached object which is only loaded when it is first accessed
+class LazyObject : public XMLObject {
+
+	public:
+
+		LazyObject() : XMLObject("lazy"), value(0), loads(0) {
+			subscribeXMLAttribute("", "value", XML_TYPE_INT, &value);
+			setXMLLazyLoad(true);
+		}
+
+		int value;
+		int loads; // number of readXML calls
+
+	protected:
+
+		bool readXML(XMLElement *e) {
+			loads++;
+			return true;
+		}
+};
+
+// holds a lazy object
+class LazyParent : public XMLObject {
+
+	public:
+
+		LazyParent() : XMLObject("lazytest") {
+			addXMLObject(&lazy);
+		}
+
+		LazyObject lazy;
+};
+
+// load a parent with a lazy object, the object's values must only be read
+// on the first ensureXMLLoaded() or before the parent is saved, returns false
+// if the object was loaded too early, not at all or more than once
+bool lazyTest() {
+	XMLDocument doc;
+	XMLElement *root = doc.NewElement("lazytest");
+	doc.InsertEndChild(root);
+	XMLElement *e = doc.NewElement("lazy");
+	e->SetAttribute("value", 5);
+	root->InsertEndChild(e);
+	LazyParent parent;
+	parent.loadXML(root);
+	if(!parent.lazy.isXMLLoadPending() || parent.lazy.loads != 0 || parent.lazy.value != 0) {
+		cout << "    FAILED: lazy object loaded with its parent" << endl;
+		return false;
+	}
+
+	// the first access loads, the second finds nothing pending
+	if(!parent.lazy.ensureXMLLoaded() || !parent.lazy.ensureXMLLoaded()) {
+		cout << "    FAILED: ensureXMLLoaded returned false" << endl;
+		return false;
+	}
+	cout << "    value: " << parent.lazy.value << ", loads: " << parent.lazy.loads << endl;
+	if(parent.lazy.isXMLLoadPending() || parent.lazy.loads != 1 || parent.lazy.value != 5) {
+		cout << "    FAILED: value " << parent.lazy.value << " after " << parent.lazy.loads
+		     << " loads, expected 5 after 1 load" << endl;
+		return false;
+	}
+
+	// a pending load happens before saving so the old value isn't written back
+	e->SetAttribute("value", 7);
+	parent.loadXML(root);
+	parent.saveXML(root);
+	if(parent.lazy.isXMLLoadPending() || parent.lazy.loads != 2 || parent.lazy.value != 7) {
+		cout << "    FAILED: value " << parent.lazy.value << " after " << parent.lazy.loads
+		     << " loads when saving, expected 7 after 2 loads" << endl;
+		return false;
+	}
+	return true;
+}
+
+// publish a snapshot after each change to a document while another thread
+// reads the latest one, both values are changed together so a reader must
+// never see them differ, returns false if a snapshot was missing, partly
+// changed or changed after it was published
+bool snapshotTest() {
+	XMLObject object("snapshottest");
+	object.initXML();
+	object.setXMLTextInt("a", 0);
+	object.setXMLTextInt("b", 0);
+	object.publishXMLSnapshot();
+	shared_ptr<const XMLSnapshot> first = object.getXMLSnapshot();
+	if(!first) {
+		cout << "    FAILED: nothing published" << endl;
+		return false;
+	}
+
+	atomic<bool> done(false);
+	atomic<int> reads(0), bad(0);
+	thread reader([&]() {
+		while(!done) {
+			shared_ptr<const XMLSnapshot> snapshot = object.getXMLSnapshot();
+			if(!snapshot || snapshot->getXMLTextInt("a") != snapshot->getXMLTextInt("b")) {
+				bad++;
+			}
+			reads++;
+		}
+	});
+	for(int i = 1; i <= 1000; ++i) {
+		object.setXMLTextInt("a", i);
+		object.setXMLTextInt("b", i);
+		object.publishXMLSnapshot();
+	}
+	done = true;
+	reader.join();
+	cout << "    reads: " << reads << ", bad reads: " << bad << endl;
+	if(bad > 0) {
+		return false;
+	}
+
+	// a snapshot keeps its values while it is held
+	shared_ptr<const XMLSnapshot> last = object.getXMLSnapshot();
+	if(first->getXMLTextInt("a", -1) != 0 || last->getXMLTextInt("a", -1) != 1000) {
+		cout << "    FAILED: first snapshot a " << first->getXMLTextInt("a", -1)
+		     << ", last snapshot a " << last->getXMLTextInt("a", -1)
+		     << ", expected 0 & 1000" << endl;
+		return false;
+	}
+	return true;
+}
+
+// decodes its values & those of an attached shape into a published set
+class BufferedObject : public XMLObject {
+
+	public:
+
+		BufferedObject() : XMLObject("bufferedtest"), count(0) {
+			subscribeXMLAttribute("", "count", XML_TYPE_INT, &count);
+			subscribeXMLElement("name", XML_TYPE_STRING, &name);
+			addXMLObject(&circle);
+			setXMLBufferedLoad(true);
+		}
+
+		int count;
+		string name;
+		Circle circle;
+};
+
+// load buffered values twice, the variables must only change when the
+// published set is applied & a held set must keep its values, returns false
+// if a variable changed early or a value was missing or wrong
+bool bufferedTest() {
+	XMLDocument doc;
+	XMLElement *root = doc.NewElement("bufferedtest");
+	doc.InsertEndChild(root);
+	root->SetAttribute("count", 3);
+	XMLElement *name = doc.NewElement("name");
+	name->SetText("first");
+	root->InsertEndChild(name);
+	XMLElement *circle = doc.NewElement("circle");
+	circle->SetAttribute("size", 4);
+	root->InsertEndChild(circle);
+	BufferedObject object;
+	object.loadXML(root);
+	shared_ptr<const XMLBoundValues> first = object.getXMLBoundValues();
+	if(!first) {
+		cout << "    FAILED: nothing published" << endl;
+		return false;
+	}
+	cout << "    values: " << first->size() << ", sequence: " << first->getSequence() << endl;
+	if(object.count != 0 || object.name != "" || object.circle.size != 0) {
+		cout << "    FAILED: variables changed before applying" << endl;
+		return false;
+	}
+	if(first->size() != 3 || first->get(&object.count) != 3 ||
+	   first->get(&object.name) != "first" || first->get(&object.circle.size) != 4) {
+		cout << "    FAILED: wrong published values" << endl;
+		return false;
+	}
+
+	// the next load publishes a new set without touching the variables
+	object.applyXMLBoundValues();
+	root->SetAttribute("count", 5);
+	name->SetText("second");
+	object.loadXML(root);
+	shared_ptr<const XMLBoundValues> second = object.getXMLBoundValues();
+	if(object.count != 3 || object.name != "first" || object.circle.size != 4) {
+		cout << "    FAILED: count " << object.count << " name \"" << object.name
+		     << "\" size " << object.circle.size << " after applying, expected 3 \"first\" 4" << endl;
+		return false;
+	}
+	if(second == first || second->getSequence() <= first->getSequence() ||
+	   first->get(&object.count) != 3 || second->get(&object.count) != 5) {
+		cout << "    FAILED: reload did not publish a new set" << endl;
+		return false;
+	}
+	object.applyXMLBoundValues();
+	if(object.count != 5 || object.name != "second") {
+		cout << "    FAILED: count " << object.count << " name \"" << object.name
+		     << "\" after applying, expected 5 \"second\"" << endl;
+		return false;
+	}
+	return true;
+}
+
+// queue lines to an async sink which hands them to a callback, lines are
+// written via LogSink::print() like Log does, returns false if a line was
+// dropped, changed or out of order
+bool asyncSinkTest() {
+	vector<string> lines; // only written by the sink thread until flushed
+	LogAsyncSink sink([&lines](LogLevel::Level level, const char *line, size_t length) {
+		lines.push_back(string(line, length));
+	});
+	LogSink::setSink(&sink);
+	for(int i = 0; i < 10; ++i) {
+		string line = "async line " + to_string(i) + "\n";
+		LogSink::print(LogLevel::LOG_LEVEL_NORMAL, line.c_str(), line.size());
+	}
+	LogSink::print(LogLevel::LOG_LEVEL_WARN, "async warning\n", 14);
+	sink.flush();
+	LogSink::setSink(NULL);
+	cout << "    lines: " << lines.size() << ", dropped: " << sink.getDropped() << endl;
+	if(lines.size() != 11 || sink.getDropped() != 0) {
+		cout << "    FAILED: expected 11 lines" << endl;
+		return false;
+	}
+	for(int i = 0; i < 10; ++i) {
+		if(lines[i] != "async line " + to_string(i) + "\n") {
+			cout << "    FAILED: line " << i << " is \"" << lines[i] << "\"" << endl;
+			return false;
+		}
+	}
+	if(lines[10] != "Warn: async warning\n") {
+		cout << "    FAILED: warning is \"" << lines[10] << "\"" << endl;
+		return false;
+	}
+	return true;
+}
+
+// replace & destroy async sinks while another thread keeps logging, every
+// line must end up in a sink or be counted as dropped by it, returns false
+// if a line went missing, a released sink crashes instead
+bool sinkReleaseTest() {
+	atomic<long> received(0);
+	LogAsyncSink::Callback count = [&received](LogLevel::Level level, const char *line, size_t length) {
+		received++;
+	};
+	long dropped = 0;
+	LogAsyncSink *sink = new LogAsyncSink(count, 64);
+	LogSink::setSink(sink);
+
+	atomic<bool> done(false);
+	atomic<long> sent(0);
+	thread logger([&]() {
+		while(!done) {
+			LogSink::print(LogLevel::LOG_LEVEL_NORMAL, "release line\n", 13);
+			sent++;
+		}
+	});
+	for(int i = 0; i < 20; ++i) {
+		this_thread::sleep_for(chrono::milliseconds(1));
+		LogAsyncSink *next = new LogAsyncSink(count, 64);
+		LogSink::setSink(next); // lines still using the previous sink are done
+		dropped += sink->getDropped();
+		delete sink;
+		sink = next;
+	}
+	done = true;
+	logger.join();
+	LogSink::setSink(NULL);
+	dropped += sink->getDropped();
+	delete sink;
+	cout << "    sent: " << sent << ", received: " << received << ", dropped: " << dropped << endl;
+	if(received + dropped != sent) {
+		cout << "    FAILED: " << sent - received - dropped << " lines missing" << endl;
+		return false;
+	}
+	return true;
+}
+
+// rate limit lines & discard them below the threshold, returns false if a
+// line was let through or suppressed when it should not have been
+bool rateLimitTest() {
+
+	// a burst of 3 lines per 200 ms, the suppressed count is reported with
+	// the first line of the next interval
+	LogLimit limit(3, 200);
+	long checks[6];
+	for(int i = 0; i < 5; ++i) {
+		checks[i] = limit.check();
+	}
+	this_thread::sleep_for(chrono::milliseconds(250));
+	checks[5] = limit.check();
+	const long expected[6] = {0, 0, 0, -1, -1, 2};
+	for(int i = 0; i < 6; ++i) {
+		if(checks[i] != expected[i]) {
+			cout << "    FAILED: check " << i << " returned " << checks[i]
+			     << ", expected " << expected[i] << endl;
+			return false;
+		}
+	}
+
+	// repeated library warnings are limited to a burst of 5 per second
+	atomic<int> warnings(0);
+	LogAsyncSink sink([&warnings](LogLevel::Level level, const char *line, size_t length) {
+		warnings++;
+	});
+	LogSink::setSink(&sink);
+	vector<XMLAttr> attrs;
+	for(int i = 0; i < 20; ++i) {
+		XML::getAttrs(NULL, attrs);
+	}
+	sink.flush();
+	int limited = warnings;
+
+	// lines below the threshold are discarded before the limit counts them
+	warnings = 0;
+	LogSink::setThreshold(LogLevel::LOG_LEVEL_ERROR);
+	for(int i = 0; i < 20; ++i) {
+		XML::getChild((XMLElement*)NULL, "foo");
+	}
+	LogSink::setThreshold(LogLevel::LOG_LEVEL_DEBUG);
+	sink.flush();
+	int discarded = warnings;
+	XML::getChild((XMLElement*)NULL, "foo");
+	sink.flush();
+	LogSink::setSink(NULL);
+	cout << "    limited: " << limited << ", discarded: " << discarded
+	     << ", after threshold: " << warnings << endl;
+	if(limited < 1 || limited > 5 || discarded != 0 || warnings != 1) {
+		cout << "    FAILED: expected 1-5 limited, 0 discarded & 1 after threshold" << endl;
+		return false;
+	}
+	return true;
+}
+
+// compare a read status to the expected one, returns false if they differ
+bool checkStatus(const char *what, XMLStatus status, XMLStatus expected) {
+	if(status != expected) {
+		cout << "    FAILED: " << what << " status " << status << ", expected " << expected << endl;
+		return false;
+	}
+	return true;
+}
+
+// read values which are found, missing, of the wrong type or on a NULL
+// element, returns false if a status or a value is wrong
+bool tryGetTest() {
+	XMLDocument doc;
+	XMLElement *e = doc.NewElement("trytest");
+	doc.InsertEndChild(e);
+	e->SetText("12");
+	e->SetAttribute("float", "3.5");
+	e->SetAttribute("bool", "true");
+	e->SetAttribute("string", "abc");
+	XMLElement *empty = doc.NewElement("empty");
+	e->InsertEndChild(empty);
+
+	XMLResult<int> text = XML::tryGetText<int>(e);
+	XMLResult<float> attr = XML::tryGetAttr<float>(e, "float");
+	XMLResult<bool> b = XML::tryGetAttr<bool>(e, "bool");
+	XMLResult<const char*> str = XML::tryGetAttr<const char*>(e, "string");
+	bool ret = checkStatus("text int", text.status, XML_STATUS_OK) &&
+	           checkStatus("attr float", attr.status, XML_STATUS_OK) &&
+	           checkStatus("attr bool", b.status, XML_STATUS_OK) &&
+	           checkStatus("attr string", str.status, XML_STATUS_OK);
+	if(ret && (text.value != 12 || attr.value != 3.5f || !b.value || string(str.value) != "abc")) {
+		cout << "    FAILED: read " << text.value << " " << attr.value << " " << b.value
+		     << " \"" << str.value << "\", expected 12 3.5 1 \"abc\"" << endl;
+		return false;
+	}
+
+	// failed reads report why & fall back to the default value
+	XMLResult<double> wrong = XML::tryGetAttr<double>(e, "string");
+	ret = ret && checkStatus("attr string as double", wrong.status, XML_STATUS_WRONG_TYPE) &&
+	      checkStatus("missing attr", XML::tryGetAttr<int>(e, "missing").status, XML_STATUS_NOT_FOUND) &&
+	      checkStatus("missing text", XML::tryGetText<float>(empty).status, XML_STATUS_NOT_FOUND) &&
+	      checkStatus("missing text string", XML::tryGetText<const char*>(empty).status, XML_STATUS_NOT_FOUND) &&
+	      checkStatus("NULL text", XML::tryGetText<unsigned int>(NULL).status, XML_STATUS_NULL_ELEMENT) &&
+	      checkStatus("NULL attr", XML::tryGetAttr<bool>(NULL, "bool").status, XML_STATUS_NULL_ELEMENT);
+	if(ret && (wrong.ok() || wrong.valueOr(-1.0) != -1.0)) {
+		cout << "    FAILED: wrong type read returned " << wrong.valueOr(-1.0) << endl;
+		return false;
+	}
+	return ret;
+}
+
+// number arrays as element text & attributes
+class ArrayObject : public XMLObject {
+
+	public:
+
+		ArrayObject() : XMLObject("arraytest") {
+			subscribeXMLElement("ints", XML_TYPE_INT_ARRAY, &ints);
+			subscribeXMLAttribute("floats", "values", XML_TYPE_FLOAT_ARRAY, &floats);
+			subscribeXMLElement("doubles", XML_TYPE_DOUBLE_ARRAY, &doubles);
+		}
+
+		vector<int> ints;
+		vector<float> floats;
+		vector<double> doubles;
+};
+
+// save arrays & load them into another object, values must come back exactly,
+// also parse mixed separators & a bad value, returns false on a mismatch
+bool arrayTest() {
+	ArrayObject saved;
+	saved.ints = {1, -2, 0, 2147483647};
+	saved.floats = {0.1f, -2.5f, 1e-7f};
+	saved.doubles = {1.0/3.0, -1e300, 0};
+	saved.initXML();
+	saved.saveXML(saved.getXMLElement());
+	ArrayObject loaded;
+	loaded.ints = {5, 6, 7, 8, 9}; // replaced, not appended to
+	loaded.loadXML(saved.getXMLElement());
+	cout << "    ints: " << loaded.ints.size() << ", floats: " << loaded.floats.size()
+	     << ", doubles: " << loaded.doubles.size() << endl;
+	if(loaded.ints != saved.ints || loaded.floats != saved.floats || loaded.doubles != saved.doubles) {
+		cout << "    FAILED: loaded arrays differ from the saved ones" << endl;
+		return false;
+	}
+
+	// whitespace & commas both separate values, an empty text is an empty array
+	XMLDocument doc;
+	XMLElement *e = doc.NewElement("array");
+	doc.InsertEndChild(e);
+	e->SetText("1, 2\t3 ,4");
+	vector<int> values;
+	if(!XML::getTextArray(e, values) || values != vector<int>({1, 2, 3, 4})) {
+		cout << "    FAILED: \"1, 2\\t3 ,4\" not read as 4 values" << endl;
+		return false;
+	}
+	e->SetText("");
+	if(!XML::getTextArray(e, values) || !values.empty()) {
+		cout << "    FAILED: empty text not read as an empty array" << endl;
+		return false;
+	}
+	e->SetAttribute("values", "1.5 x 3");
+	vector<double> bad;
+	if(XML::getAttrArray(e, "values", bad)) {
+		cout << "    FAILED: \"1.5 x 3\" read as numbers" << endl;
+		return false;
+	}
+	return true;
+}
+
+// a part of a hierarchy which is loaded & saved with or without a compiled
+// plan, appends its name & values to a shared call log in its callbacks
+class PlanPart : public XMLObject {
+
+	public:
+
+		PlanPart(string name, string *calls) : XMLObject(name),
+			size(0), weight(0), calls(calls) {
+			subscribeXMLAttribute("", "size", XML_TYPE_INT, &size);
+			subscribeXMLElement("weight", XML_TYPE_FLOAT, &weight);
+			subscribeXMLElement("info/label", XML_TYPE_STRING, &label);
+			subscribeXMLAttribute("info/label", "lang", XML_TYPE_STRING, &lang);
+		}
+
+		// values as text for comparisons
+		string getValues() {
+			return getXMLName() + " " + to_string(size) + " " + to_string(weight) +
+			       " " + label + " " + lang + "\n";
+		}
+
+		int size;
+		float weight;
+		string label;
+		string lang;
+
+	protected:
+
+		bool readXML(XMLElement *e) {
+			*calls += "read " + getValues();
+			return true;
+		}
+
+		bool writeXML(XMLElement *e) {
+			*calls += "write " + getValues();
+			return true;
+		}
+
+		string *calls;
+};
+
+// two parts with the same element name, a part with a nested part & values
+// of its own
+class PlanRoot : public XMLObject {
+
+	public:
+
+		PlanRoot() : XMLObject("plantest"), version(0),
+			front("wheel", &calls), back("wheel", &calls),
+			body("body", &calls), door("door", &calls) {
+			subscribeXMLAttribute("", "version", XML_TYPE_INT, &version);
+			subscribeXMLElement("title", XML_TYPE_STRING, &title);
+			addXMLObject(&front);
+			addXMLObject(&back);
+			body.addXMLObject(&door);
+			addXMLObject(&body);
+		}
+
+		// set different values in every part
+		void fill() {
+			version = 2;
+			title = "car";
+			PlanPart *parts[] = {&front, &back, &body, &door};
+			for(int i = 0; i < 4; ++i) {
+				parts[i]->size = i + 1;
+				parts[i]->weight = 0.5f * (i + 1);
+				parts[i]->label = "part " + to_string(i);
+				parts[i]->lang = (i % 2 ? "de" : "en");
+			}
+		}
+
+		// values of this object & all parts as text for comparisons
+		string getValues() {
+			return to_string(version) + " " + title + "\n" + front.getValues() +
+			       back.getValues() + body.getValues() + door.getValues();
+		}
+
+		int version;
+		string title;
+		string calls;
+
+		PlanPart front, back, body, door;
+};
+
+// an element, its attributes, text & children as text for comparisons
+string treeToString(const XMLElement *e, int depth=0) {
+	string s = string(depth*2, ' ') + e->Name();
+	for(const XMLAttribute *attr = e->FirstAttribute(); attr != NULL; attr = attr->Next()) {
+		s += string(" ") + attr->Name() + "=" + attr->Value();
+	}
+	if(e->GetText() != NULL) {
+		s += string(" \"") + e->GetText() + "\"";
+	}
+	s += "\n";
+	for(const XMLElement *child = e->FirstChildElement(); child != NULL; child = child->NextSiblingElement()) {
+		s += treeToString(child, depth+1);
+	}
+	return s;
+}
+
+// save & load the same hierarchy with & without a compiled plan, twice each
+// so the plan is reused, the saved trees, loaded values & callbacks must be
+// the same in both modes, returns false if they differ
+bool planTest() {
+	XMLDocument doc;
+	XMLElement *source = doc.NewElement("plantest");
+	doc.InsertEndChild(source);
+	string trees[2], values[2], calls[2];
+	for(int plan = 0; plan < 2; ++plan) {
+		XMLElement *root = doc.NewElement("plantest");
+		doc.InsertEndChild(root);
+		PlanRoot saved;
+		saved.setXMLPlanEnabled(plan);
+		saved.fill();
+		saved.saveXML(root);
+		saved.saveXML(root); // reuses the elements of the first save
+		trees[plan] = treeToString(root);
+		calls[plan] = saved.calls;
+		if(plan == 0) {
+			saved.saveXML(source);
+		}
+		doc.DeleteChild(root);
+
+		PlanRoot loaded;
+		loaded.setXMLPlanEnabled(plan);
+		loaded.loadXML(source);
+		loaded.loadXML(source);
+		values[plan] = loaded.getValues();
+		calls[plan] += loaded.calls;
+		if(values[plan] != saved.getValues()) {
+			cout << "    FAILED: loaded values differ from the saved ones" << (plan ? " with plan" : "")
+			     << endl << values[plan] << "expected" << endl << saved.getValues();
+			return false;
+		}
+	}
+	cout << "    saved tree:" << endl << trees[0];
+	if(trees[0] != trees[1]) {
+		cout << "    FAILED: saved tree with plan differs" << endl << trees[1];
+		return false;
+	}
+	if(calls[0] != calls[1]) {
+		cout << "    FAILED: callbacks with plan differ" << endl << calls[0] << "plan:" << endl << calls[1];
+		return false;
+	}
+	return true;
+}
+
+// read cached values & change them, only the changed values may be read
+// again, returns false if a stale value was returned after a set function,
+// a reload or clearing the cache
+bool cacheTest() {
+	XMLObject object("cachetest");
+	object.initXML();
+	object.setXMLTextInt("a", 1);
+	object.setXMLAttrString("b", "name", "first");
+	object.setXMLValueCacheEnabled(true);
+	if(object.getXMLTextInt("a") != 1 || object.getXMLTextString("a") != "1" ||
+	   object.getXMLAttrString("b", "name") != "first" || object.getXMLTextInt("missing", 5) != 5) {
+		cout << "    FAILED: wrong first reads" << endl;
+		return false;
+	}
+
+	// setting a value drops it for all types, a failed read is dropped when
+	// the missing element may have been created
+	object.setXMLTextInt("a", 2);
+	object.setXMLAttrString("b", "name", "second");
+	object.setXMLTextInt("missing", 9);
+	cout << "    a: " << object.getXMLTextInt("a") << " \"" << object.getXMLTextString("a")
+	     << "\", b name: " << object.getXMLAttrString("b", "name")
+	     << ", missing: " << object.getXMLTextInt("missing", 5) << endl;
+	if(object.getXMLTextInt("a") != 2 || object.getXMLTextString("a") != "2" ||
+	   object.getXMLAttrString("b", "name") != "second" || object.getXMLTextInt("missing", 5) != 9) {
+		cout << "    FAILED: stale value after set" << endl;
+		return false;
+	}
+
+	// changing the document directly needs the cache to be cleared, setting
+	// another attribute of the same element keeps the cached one, numbers
+	// are cached by value so the stale one can still be read
+	object.setXMLAttrInt("b", "size", 1);
+	object.getXMLAttrInt("b", "size");
+	object.getXMLChild("b")->SetAttribute("size", 4);
+	object.setXMLAttrString("b", "other", "x");
+	if(object.getXMLAttrInt("b", "size") != 1) {
+		cout << "    FAILED: setting another attribute dropped the cached one" << endl;
+		return false;
+	}
+	object.clearXMLValueCache();
+	if(object.getXMLAttrInt("b", "size") != 4) {
+		cout << "    FAILED: stale value after clearing the cache" << endl;
+		return false;
+	}
+
+	// loading clears the cache
+	object.getXMLChild("a")->SetText("3");
+	object.loadXML(object.getXMLElement());
+	if(object.getXMLTextInt("a") != 3) {
+		cout << "    FAILED: stale value after reloading" << endl;
+		return false;
+	}
+	return true;
+}
+
+// read many attributes at once with repeated & missing names, also reuse an
+// index with enough names to grow its table for elements with different
+// attributes, returns false if a value or count is wrong
+bool attrsTest() {
+	XMLDocument doc;
+	XMLElement *e = doc.NewElement("attrstest");
+	doc.InsertEndChild(e);
+	e->SetAttribute("x", 1);
+	e->SetAttribute("y", "2.5");
+	e->SetAttribute("name", "abc");
+
+	// a repeated name fills both variables, a missing one gets the default
+	int a = 0, b = 0, missing = 7;
+	float y = 0;
+	string name;
+	vector<XMLAttr> attrs;
+	attrs.push_back(XMLAttr("x", XML_TYPE_INT, &a));
+	attrs.push_back(XMLAttr("missing", XML_TYPE_INT, &missing));
+	attrs.push_back(XMLAttr("name", XML_TYPE_STRING, &name));
+	attrs.push_back(XMLAttr("x", XML_TYPE_INT, &b));
+	attrs.push_back(XMLAttr("y", XML_TYPE_FLOAT, &y));
+	size_t found = XML::getAttrs(e, attrs);
+	cout << "    found: " << found << ", x: " << a << " " << b << ", missing: " << missing
+	     << ", name: " << name << ", y: " << y << endl;
+	if(found != 4 || a != 1 || b != 1 || missing != 0 || name != "abc" || y != 2.5f) {
+		cout << "    FAILED: expected 4 found, x 1 1, missing 0, name abc, y 2.5" << endl;
+		return false;
+	}
+
+	// 12 names with a repeat, attributes in reverse order
+	XMLAttrIndex index;
+	for(int i = 0; i < 12; ++i) {
+		index.add("a" + to_string(i));
+	}
+	int repeat = index.add("a3");
+	index.add("none");
+	for(int i = 11; i >= 0; --i) {
+		e->SetAttribute(("a" + to_string(i)).c_str(), i);
+	}
+	if(index.find("a3") != 3 || index.next(3) != repeat || index.next(repeat) != -1 || index.find("x") != -1) {
+		cout << "    FAILED: wrong index entries" << endl;
+		return false;
+	}
+	vector<const char*> values(index.size());
+	found = XML::findAttrs(e, index, values.data());
+	bool ret = (found == 13 && values[repeat] != NULL && string(values[repeat]) == "3" && values[13] == NULL);
+	for(int i = 0; i < 12 && ret; ++i) {
+		ret = (values[i] != NULL && string(values[i]) == to_string(i));
+	}
+	if(!ret) {
+		cout << "    FAILED: findAttrs found " << found << ", expected 13 with matching values" << endl;
+		return false;
+	}
+
+	// values found for the previous element are reset
+	XMLElement *other = doc.NewElement("other");
+	e->InsertEndChild(other);
+	other->SetAttribute("a5", 5);
+	found = XML::findAttrs(other, index, values.data());
+	for(size_t i = 0; i < values.size() && ret; ++i) {
+		ret = (i == 5 ? values[i] != NULL : values[i] == NULL);
+	}
+	if(found != 1 || !ret) {
+		cout << "    FAILED: findAttrs found " << found << " on the other element, expected only a5" << endl;
+		return false;
+	}
+	return true;
+}
+
 int main(int argc, char *argv[]) {
 	cout << endl;
 	
@@ -245,6 +1242,128 @@ int main(int argc, char *argv[]) {
 	Processor processor;
 	processor.loadXMLFile("../../data/test.xml");
 	
+	// allocation counts for a warmed up reload, needs --enable-alloc-count
+	if(XMLAlloc::isEnabled() && processor.getXMLRootElement()) {
+		cout << "ALLOCATION TEST" << endl;
+		if(!allocTest(processor.getXMLRootElement())) {
+			return 1;
+		}
+		cout << "DONE" << endl << endl;
+	}
+	
+	// load values through a binding table
+	if(processor.getXMLRootElement()) {
+		cout << "BINDING TEST" << endl;
+		if(!bindingTest(processor.getXMLRootElement())) {
+			return 1;
+		}
+		cout << "DONE" << endl << endl;
+	}
+	
+	// grow a vector of objects stored in place across reloads
+	cout << "LIST TEST" << endl;
+	if(!listTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// create objects by element name & recycle them across reloads
+	cout << "FACTORY TEST" << endl;
+	if(!factoryTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// defer loading an attached object until it is accessed
+	cout << "LAZY TEST" << endl;
+	if(!lazyTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// read published snapshots while the document changes
+	cout << "SNAPSHOT TEST" << endl;
+	if(!snapshotTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// publish decoded values & apply them later
+	cout << "BUFFERED TEST" << endl;
+	if(!bufferedTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// write log lines on a background thread
+	cout << "ASYNC SINK TEST" << endl;
+	if(!asyncSinkTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// release log sinks while another thread is logging
+	cout << "SINK RELEASE TEST" << endl;
+	if(!sinkReleaseTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// rate limit & discard log lines
+	cout << "RATE LIMIT TEST" << endl;
+	if(!rateLimitTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// read values with a status instead of logging
+	cout << "TRY GET TEST" << endl;
+	if(!tryGetTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// save & load number arrays
+	cout << "ARRAY TEST" << endl;
+	if(!arrayTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// load & save with a compiled plan like without one
+	cout << "PLAN TEST" << endl;
+	if(!planTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// cache converted values & drop them when they change
+	cout << "VALUE CACHE TEST" << endl;
+	if(!cacheTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// read many attributes in a single walk
+	cout << "ATTRIBUTES TEST" << endl;
+	if(!attrsTest()) {
+		return 1;
+	}
+	cout << "DONE" << endl << endl;
+	
+	// extract the objecttest records into columns
+	cout << "COLUMN TEST" << endl;
+	vector<XMLColumn> columns;
+	columns.push_back(XMLColumn("", "name", XML_TYPE_STRING));
+	columns.push_back(XMLColumn("bar", "", XML_TYPE_FLOAT));
+	columns.push_back(XMLColumn("subelement/test/number", "", XML_TYPE_FLOAT));
+	size_t records = XML::getColumns(processor.getXMLChild("objecttest"), "object", columns);
+	for(size_t i = 0; i < records; ++i) {
+		cout << "    " << columns[0].getString(i) << " " << columns[1].floats[i]
+		     << " " << columns[2].floats[i] << endl;
+	}
+	cout << "DONE" << endl << endl;
+	
 	// add something from outside the main object
 	processor.setXMLTextString("test/hello", "word boy");
 	